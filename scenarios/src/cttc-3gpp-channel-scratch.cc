@@ -1,4 +1,13 @@
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
 
 #include "ns3/core-module.h"
 #include "ns3/config-store-module.h"
@@ -13,11 +22,39 @@
 #include "ns3/nr-module.h"
 #include "ns3/antenna-module.h"
 #include "ns3/point-to-point-helper.h"
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/lte-pdcp.h"
+#include "ns3/lte-rlc-header.h"
+#include "ns3/lte-rlc-um.h"
+
+#include "emu-simulator-impl.h"
+#include "nr-cell-limits.h"
+#include "offload-tap-bridge.h"
+#include "slot-bucket-scheduler.h"
 
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE ("5gEmu");
 
+class RlcTxAccounting;
+
+// State of the per-subsystem memory accounting, see --memoryReport
+struct MemoryAccounting
+{
+  std::ofstream report;
+  uint32_t numUes = 0;
+  uint64_t startRssKb = 0;
+  // bytes handed to RLC UM by PDCP, minus SDUs RLC dropped and the payload
+  // of the PDUs it sent to MAC
+  int64_t rlcBytes = 0;
+  std::set<Ptr<LteRlc>> connectedBearers;
+  std::vector<std::unique_ptr<RlcTxAccounting>> rlcTaps;
+  std::map<std::string, uint64_t> last;
+  std::map<std::string, uint64_t> peak;
+};
+
+static MemoryAccounting g_memory;
+
 void
 Log (std::string msg)
 {
@@ -68,10 +105,322 @@ LogNodes (NodeContainer nodes)
   NS_LOG_UNCOND ("---");
 }
 
+// Resident and peak resident set size of this process, in kB
+void
+ReadProcessMemory (uint64_t &rssKb, uint64_t &peakKb)
+{
+  std::ifstream status ("/proc/self/status");
+  std::string line;
+  while (std::getline (status, line))
+    {
+      if (line.compare (0, 6, "VmRSS:") == 0)
+        {
+          rssKb = std::stoull (line.substr (6));
+        }
+      else if (line.compare (0, 6, "VmHWM:") == 0)
+        {
+          peakKb = std::stoull (line.substr (6));
+        }
+    }
+}
+
+void
+RlcEnqueued (uint16_t rnti, uint8_t lcid, uint32_t bytes)
+{
+  g_memory.rlcBytes += bytes;
+}
+
+void
+RlcDropped (Ptr<const Packet> packet)
+{
+  g_memory.rlcBytes -= packet->GetSize ();
+}
+
+// Sits between an RLC UM entity and its MAC.  The RLC TxPDU trace only gives
+// the PDU size, which includes a length indicator per concatenated SDU, so
+// the header of every PDU is parsed to take off exactly the payload it sent.
+class RlcTxAccounting : public LteMacSapProvider
+{
+public:
+  explicit RlcTxAccounting (LteMacSapProvider *mac) : m_mac (mac)
+  {
+  }
+
+  void
+  TransmitPdu (TransmitPduParameters params) override
+  {
+    LteRlcHeader header;
+    params.pdu->PeekHeader (header);
+    g_memory.rlcBytes -= params.pdu->GetSize () - header.GetSerializedSize ();
+    m_mac->TransmitPdu (params);
+  }
+
+  void
+  ReportBufferStatus (ReportBufferStatusParameters params) override
+  {
+    m_mac->ReportBufferStatus (params);
+  }
+
+private:
+  LteMacSapProvider *m_mac;
+};
+
+// LteRlc keeps the SAP towards the MAC protected, a derived type may name it
+struct RlcMacSap : LteRlc
+{
+  static LteMacSapProvider *&
+  Of (LteRlc *rlc)
+  {
+    return rlc->*(&RlcMacSap::m_macSapProvider);
+  }
+};
+
+void
+ConnectBearerTraces (std::string bearers)
+{
+  Config::MatchContainer drbs = Config::LookupMatches (bearers);
+  for (auto drb = drbs.Begin (); drb != drbs.End (); ++drb)
+    {
+      PointerValue rlcValue;
+      PointerValue pdcpValue;
+      (*drb)->GetAttribute ("LteRlc", rlcValue);
+      (*drb)->GetAttribute ("LtePdcp", pdcpValue);
+      // only UM keeps a transmit buffer that the PDU headers describe
+      Ptr<LteRlcUm> rlc = rlcValue.Get<LteRlcUm> ();
+      Ptr<LtePdcp> pdcp = pdcpValue.Get<LtePdcp> ();
+      if (!rlc || !pdcp || !g_memory.connectedBearers.insert (rlc).second)
+        {
+          continue;
+        }
+      pdcp->TraceConnectWithoutContext ("TxPDU", MakeCallback (&RlcEnqueued));
+      rlc->TraceConnectWithoutContext ("TxDrop", MakeCallback (&RlcDropped));
+      LteMacSapProvider *&mac = RlcMacSap::Of (PeekPointer (rlc));
+      g_memory.rlcTaps.emplace_back (new RlcTxAccounting (mac));
+      mac = g_memory.rlcTaps.back ().get ();
+    }
+}
+
+// Radio bearers only exist once the RRC connection is reconfigured, so their
+// PDCP/RLC traces are hooked up from here rather than at setup time
+void
+OnConnectionReconfiguration (std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+{
+  std::string rrc = context.substr (0, context.rfind ('/'));
+  std::string bearers = rrc;
+  if (rrc.find ("LteEnbRrc") != std::string::npos)
+    {
+      bearers += "/UeMap/" + std::to_string (rnti);
+    }
+  bearers += "/DataRadioBearerMap/*";
+  Simulator::ScheduleNow (&ConnectBearerTraces, bearers);
+}
+
+void
+RecordMemory (double now, const std::string &category, uint64_t value)
+{
+  g_memory.report << now << "," << category << "," << value << "\n";
+  g_memory.last[category] = value;
+  g_memory.peak[category] = std::max (g_memory.peak[category], value);
+}
+
+void
+SampleMemory (Time interval)
+{
+  double now = Simulator::Now ().GetSeconds ();
+  uint64_t rssKb = 0;
+  uint64_t peakKb = 0;
+  ReadProcessMemory (rssKb, peakKb);
+  RecordMemory (now, "rss_kb", rssKb);
+  RecordMemory (now, "peak_rss_kb", peakKb);
+  RecordMemory (now, "per_ue_kb",
+                rssKb > g_memory.startRssKb ? (rssKb - g_memory.startRssKb) / g_memory.numUes : 0);
+
+  Ptr<EmuSimulatorImpl> impl = DynamicCast<EmuSimulatorImpl> (Simulator::GetImplementation ());
+  for (const auto &pending : impl->GetPendingEvents ())
+    {
+      RecordMemory (now, "events:" + pending.first, pending.second);
+    }
+
+  uint64_t csmaBytes = 0;
+  uint64_t p2pBytes = 0;
+  for (auto node = NodeList::Begin (); node != NodeList::End (); ++node)
+    {
+      for (uint32_t d = 0; d < (*node)->GetNDevices (); ++d)
+        {
+          Ptr<NetDevice> device = (*node)->GetDevice (d);
+          if (Ptr<CsmaNetDevice> csma = DynamicCast<CsmaNetDevice> (device))
+            {
+              csmaBytes += csma->GetQueue ()->GetNBytes ();
+            }
+          else if (Ptr<PointToPointNetDevice> p2p = DynamicCast<PointToPointNetDevice> (device))
+            {
+              p2pBytes += p2p->GetQueue ()->GetNBytes ();
+            }
+        }
+    }
+  RecordMemory (now, "csma_queue_bytes", csmaBytes);
+  RecordMemory (now, "p2p_queue_bytes", p2pBytes);
+  NS_ASSERT_MSG (g_memory.rlcBytes >= 0, "RLC accounting sent more than it buffered");
+  RecordMemory (now, "rlc_buffer_bytes", std::max<int64_t> (g_memory.rlcBytes, 0));
+
+  uint64_t pcapBytes = 0;
+  std::error_code error;
+  for (const auto &entry : std::filesystem::directory_iterator (".", error))
+    {
+      std::string name = entry.path ().filename ().string ();
+      if (name.rfind ("5gEmu", 0) == 0 && entry.path ().extension () == ".pcap")
+        {
+          pcapBytes += entry.file_size (error);
+        }
+    }
+  // disk usage, not memory; kept in the CSV to relate capture size to load
+  RecordMemory (now, "pcap_disk_bytes", pcapBytes);
+  g_memory.report.flush ();
+
+  Simulator::Schedule (interval, &SampleMemory, interval);
+}
+
+// Where the memory went at the last sample, largest measured consumers first.
+// Pending events are only counted, their size depends on the bound callback.
+void
+LogMemoryReport ()
+{
+  uint64_t rssBytes = g_memory.last["rss_kb"] * 1024;
+  std::vector<std::pair<uint64_t, std::string>> consumers;
+  std::vector<std::pair<uint64_t, std::string>> events;
+  uint64_t totalEvents = 0;
+  for (const auto &sample : g_memory.last)
+    {
+      if (sample.first.rfind ("events:", 0) == 0)
+        {
+          totalEvents += sample.second;
+          events.emplace_back (sample.second, sample.first.substr (7));
+        }
+    }
+  std::sort (events.rbegin (), events.rend ());
+  consumers.emplace_back (g_memory.last["rlc_buffer_bytes"], "RLC UM buffers");
+  consumers.emplace_back (g_memory.last["csma_queue_bytes"], "CSMA device queues");
+  consumers.emplace_back (g_memory.last["p2p_queue_bytes"], "P2P device queues");
+  uint64_t known = 0;
+  for (const auto &consumer : consumers)
+    {
+      known += consumer.first;
+    }
+  std::sort (consumers.rbegin (), consumers.rend ());
+
+  NS_LOG_UNCOND ("Memory report (" << g_memory.numUes << " UEs)");
+  NS_LOG_UNCOND ("\tRSS: " << g_memory.last["rss_kb"] << " kB, peak " << g_memory.last["peak_rss_kb"]
+                           << " kB, " << g_memory.last["per_ue_kb"] << " kB per UE");
+  for (const auto &consumer : consumers)
+    {
+      NS_LOG_UNCOND ("\t" << consumer.second << ": " << consumer.first / 1024 << " kB");
+    }
+  NS_LOG_UNCOND ("\tnot measured (events, packets outside the queues above, NR PHY and spectrum "
+                 "buffers, trace sinks, other model state): "
+                 << (rssBytes > known ? rssBytes - known : 0) / 1024 << " kB");
+  NS_LOG_UNCOND ("\tpcap written to disk: " << g_memory.last["pcap_disk_bytes"] / 1024 << " kB");
+  NS_LOG_UNCOND ("\t" << totalEvents << " pending events");
+  for (const auto &pending : events)
+    {
+      NS_LOG_UNCOND ("\t\t" << pending.second << ": " << pending.first);
+    }
+}
+
 int
 main (int argc, char *argv[])
 {
-  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::RealtimeSimulatorImpl"));
+  uint32_t numUes = 2;
+  uint32_t numGnbs = 1;
+  bool lowMemory = false;
+  std::string memoryReport = "";
+  Time memorySampleInterval = Seconds (1);
+  double timeDilation = 0;
+  Time slipBudget = MilliSeconds (1);
+  bool profile = false;
+  uint32_t profileSampling = 1;
+  bool offload = false;
+  std::string scheduler = "map";
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("numUes", "Number of UEs, the first two are bridged to the tap devices", numUes);
+  cmd.AddValue ("numGnbs", "Number of cells, extra UEs are spread evenly over them", numGnbs);
+  cmd.AddValue ("lowMemory",
+                "Write a single promiscuous pcap instead of one per CSMA device.  The "
+                "simulation is unchanged, but pcap-analyzer then has one capture point "
+                "and cannot measure loss",
+                lowMemory);
+  cmd.AddValue ("memoryReport", "CSV file for per-subsystem memory samples (empty disables)",
+                memoryReport);
+  cmd.AddValue ("memorySampleInterval", "Interval between memory samples", memorySampleInterval);
+  cmd.AddValue ("timeDilation",
+                "Run k times slower than wall-clock time instead of in realtime (0 disables), "
+                "the containers get the same factor in TIME_DILATION",
+                timeDilation);
+  cmd.AddValue ("slipBudget",
+                "How far events may fall behind their wall-clock time, used to report the "
+                "smallest usable time dilation",
+                slipBudget);
+  cmd.AddValue ("profile",
+                "Attribute the wall time of the events to callback type and node, report it "
+                "at the end and write profile-report.folded for flamegraphs",
+                profile);
+  cmd.AddValue ("profileSampling", "Time one in this many events when profiling",
+                profileSampling);
+  cmd.AddValue ("offload",
+                "Take TCP super-frames from the taps and carry them as packets of the "
+                "internet link MTU instead of the containers' MSS",
+                offload);
+  cmd.AddValue ("scheduler",
+                "Event queue: map, heap, list, calendar or slot-bucket (one bucket per slot "
+                "for the per-UE events at each slot boundary)",
+                scheduler);
+  cmd.Parse (argc, argv);
+  NS_ABORT_MSG_IF (numUes < 2, "The scenario needs at least the two tap-bridged UEs");
+  NS_ABORT_MSG_IF (numGnbs < 1, "The scenario needs at least one gNB");
+  // the tap-bridged UEs always belong to the first cell
+  uint32_t uesPerCell = 2 + (numUes - 2 + numGnbs - 1) / numGnbs;
+  NS_ABORT_MSG_IF (uesPerCell >= MAX_UES_PER_CELL,
+                   "A cell holds at most " << MAX_UES_PER_CELL - 1 << " UEs, increase --numGnbs");
+
+  if (!memoryReport.empty ())
+    {
+      uint64_t peakKb = 0;
+      ReadProcessMemory (g_memory.startRssKb, peakKb);
+      g_memory.numUes = numUes;
+      g_memory.report.open (memoryReport);
+      g_memory.report << "time_s,category,value\n";
+    }
+  // only the memory report needs every event wrapped for the pending counts
+  Config::SetDefault ("ns3::EmuSimulatorImpl::TrackPending",
+                      BooleanValue (!memoryReport.empty ()));
+  if (profile)
+    {
+      Config::SetDefault ("ns3::EmuSimulatorImpl::Profile", BooleanValue (true));
+      Config::SetDefault ("ns3::EmuSimulatorImpl::ProfileSampling",
+                          UintegerValue (profileSampling));
+      Config::SetDefault ("ns3::EmuSimulatorImpl::ProfileFolded",
+                          StringValue ("profile-report.folded"));
+    }
+  if (timeDilation > 0)
+    {
+      // EmuSimulatorImpl does the pacing on top of the default implementation
+      Config::SetDefault ("ns3::EmuSimulatorImpl::TimeDilation", DoubleValue (timeDilation));
+      GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::EmuSimulatorImpl"));
+    }
+  else if (!memoryReport.empty () || profile)
+    {
+      Config::SetDefault ("ns3::EmuSimulatorImpl::Impl",
+                          StringValue ("ns3::RealtimeSimulatorImpl"));
+      GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::EmuSimulatorImpl"));
+    }
+  else
+    {
+      GlobalValue::Bind ("SimulatorImplementationType",
+                         StringValue ("ns3::RealtimeSimulatorImpl"));
+    }
+  std::string schedulerType = SchedulerTypeName (scheduler);
+  NS_ABORT_MSG_IF (schedulerType.empty (), "Unknown scheduler " << scheduler);
+  GlobalValue::Bind ("SchedulerType", StringValue (schedulerType));
   GlobalValue::Bind ("ChecksumEnabled", BooleanValue (true));
 
   NS_LOG_INFO ("Create nodes");
@@ -87,6 +436,10 @@ main (int argc, char *argv[])
   ueNodes.Add (nodes.Get (3));
   Names::Add ("UeNode0", ueNodes.Get (0));
   Names::Add ("UeNode1", ueNodes.Get (1));
+  // UEs beyond the tap-bridged pair only load the radio network
+  NodeContainer extraUeNodes;
+  extraUeNodes.Create (numUes - 2);
+  ueNodes.Add (extraUeNodes);
 
   NS_LOG_INFO ("Create NR network");
   double frequency = 28e9;
@@ -96,17 +449,34 @@ main (int argc, char *argv[])
   double hBS = 35;
   double hUT = 1.5;
   double speed = 1;
+  double interSiteDistance = 200;
+  // MTU of the link from the PGW to the remote hosts, the largest packet the
+  // core carries without fragmenting it
+  uint16_t inetMtu = 2500;
   NodeContainer enbNodes;
   Config::SetDefault ("ns3::LteRlcUm::MaxTxBufferSize", UintegerValue (999999999));
+  Config::SetDefault ("ns3::LteEnbRrc::SrsPeriodicity",
+                      UintegerValue (SrsPeriodicityFor (uesPerCell)));
+  if (offload)
+    {
+      // room for the GTP-U, UDP and IP headers around a full-size packet
+      Config::SetDefault ("ns3::PointToPointEpcHelper::S1uLinkMtu", UintegerValue (inetMtu + 100));
+      Config::SetDefault ("ns3::NoBackhaulEpcHelper::S5LinkMtu", UintegerValue (inetMtu + 100));
+    }
 
-  enbNodes.Create (1);
-  Names::Add ("EnbNode0", enbNodes.Get (0));
+  enbNodes.Create (numGnbs);
+  for (uint32_t g = 0; g < numGnbs; ++g)
+    {
+      Names::Add ("EnbNode" + std::to_string (g), enbNodes.Get (g));
+    }
 
   NS_LOG_DEBUG ("position the base station and UEs");
   // position the base stations
   Ptr<ListPositionAllocator> enbPositionAlloc = CreateObject<ListPositionAllocator> ();
-  enbPositionAlloc->Add (Vector (0.0, 0.0, hBS));
-  enbPositionAlloc->Add (Vector (0.0, 80.0, hBS));
+  for (uint32_t g = 0; g < numGnbs; ++g)
+    {
+      enbPositionAlloc->Add (Vector (g * interSiteDistance, 0.0, hBS));
+    }
   MobilityHelper enbmobility;
   enbmobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
   enbmobility.SetPositionAllocator (enbPositionAlloc);
@@ -115,7 +485,26 @@ main (int argc, char *argv[])
   // position the mobile terminals and enable the mobility
   MobilityHelper uemobility;
   uemobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
-  uemobility.Install (ueNodes);
+  uemobility.Install (ueNodes.Get (0));
+  uemobility.Install (ueNodes.Get (1));
+
+  // extra UEs on rings around the base station of their cell
+  Ptr<ListPositionAllocator> extraUePositionAlloc = CreateObject<ListPositionAllocator> ();
+  for (uint32_t u = 0; u < extraUeNodes.GetN (); ++u)
+    {
+      uint32_t cell = u % numGnbs;
+      uint32_t index = u / numGnbs;
+      double angle = 2 * M_PI * index / (uesPerCell - 2);
+      // five rings out to 40% of the inter-site distance, so every extra UE is
+      // clearly closer to its own gNB and the per-cell SRS sizing holds
+      double radius = 20 + (0.4 * interSiteDistance - 20) * (index % 5) / 4;
+      extraUePositionAlloc->Add (Vector (cell * interSiteDistance + radius * std::cos (angle),
+                                         radius * std::sin (angle), hUT));
+    }
+  MobilityHelper extraUemobility;
+  extraUemobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  extraUemobility.SetPositionAllocator (extraUePositionAlloc);
+  extraUemobility.Install (extraUeNodes);
 
   ueNodes.Get (0)->GetObject<MobilityModel> ()->SetPosition (
       Vector (90, 15, hUT)); // (x, y, z) in m
@@ -148,6 +537,8 @@ main (int argc, char *argv[])
    * |---------------Band---------------|
    * |---------------CC-----------------|
    * |---------------BWP----------------|
+   *
+   * All cells share this band and interfere with each other.
    */
   CcBwpCreator::SimpleOperationBandConf bandConf (frequency, bandwidth, numCcPerBand, scenarioEnum);
   OperationBandInfo band = ccBwpCreator.CreateOperationBandContiguousCc (bandConf);
@@ -177,7 +568,10 @@ main (int argc, char *argv[])
   NetDeviceContainer enbNetDev = nrHelper->InstallGnbDevice (enbNodes, allBwps);
   NetDeviceContainer ueNetDev = nrHelper->InstallUeDevice (ueNodes, allBwps);
 
-  nrHelper->GetGnbPhy (enbNetDev.Get (0), 0)->SetTxPower (txPower);
+  for (uint32_t g = 0; g < numGnbs; ++g)
+    {
+      nrHelper->GetGnbPhy (enbNetDev.Get (g), 0)->SetTxPower (txPower);
+    }
 
   for (auto it = enbNetDev.Begin (); it != enbNetDev.End (); ++it)
     {
@@ -202,7 +596,7 @@ main (int argc, char *argv[])
   // connect a remoteHost to pgw. Setup routing too
   PointToPointHelper p2ph;
   p2ph.SetDeviceAttribute ("DataRate", DataRateValue (DataRate ("100Gb/s")));
-  p2ph.SetDeviceAttribute ("Mtu", UintegerValue (2500));
+  p2ph.SetDeviceAttribute ("Mtu", UintegerValue (inetMtu));
   p2ph.SetChannelAttribute ("Delay", TimeValue (Seconds (0.010)));
   NetDeviceContainer p2pInetDevs = p2ph.Install (pgw, remoteHost);
 
@@ -232,9 +626,21 @@ main (int argc, char *argv[])
   // attach UEs to the closest eNB
   nrHelper->AttachToClosestEnb (ueNetDev, enbNetDev);
 
+  if (!memoryReport.empty ())
+    {
+      Config::ConnectFailSafe ("/NodeList/*/DeviceList/*/LteEnbRrc/ConnectionReconfiguration",
+                               MakeCallback (&OnConnectionReconfiguration));
+      Config::ConnectFailSafe ("/NodeList/*/DeviceList/*/LteUeRrc/ConnectionReconfiguration",
+                               MakeCallback (&OnConnectionReconfiguration));
+    }
+
   NS_LOG_INFO ("Add ghost ues");
   CsmaHelper csmaHelper;
   csmaHelper.SetChannelAttribute ("DataRate", DataRateValue (5000000));
+  if (offload)
+    {
+      csmaHelper.SetDeviceAttribute ("Mtu", UintegerValue (inetMtu));
+    }
 
   NodeContainer csmaNodes;
   csmaNodes.Add (ghostNodes.Get (0));
@@ -273,16 +679,34 @@ staticRoutingUeNode0->AddHostRouteTo(Ipv4Address ("10.1.1.1"), Ipv4Address ("7.0
 
 
   NS_LOG_INFO ("Create tap device");
-  TapBridgeHelper tapBridge;
-  tapBridge.SetAttribute ("Mode", StringValue ("UseBridge"));
-  tapBridge.SetAttribute ("DeviceName", StringValue ("tap-left"));
-  tapBridge.Install (ghostNodes.Get (0), csmaDevices.Get (0));
-  
-  tapBridge.SetAttribute ("DeviceName", StringValue ("tap-right"));
-  tapBridge.Install (ghostNodes.Get (1), csmaDevices.Get (1));
+  const char *tapNames[] = {"tap-left", "tap-right", "tap-server"};
+  std::vector<Ptr<OffloadTapBridge>> offloadBridges;
+  if (offload)
+    {
+      Ptr<Node> tapNodes[] = {ghostNodes.Get (0), ghostNodes.Get (1), remoteHostContainer.Get (1)};
+      for (uint32_t i = 0; i < 3; ++i)
+        {
+          Ptr<OffloadTapBridge> bridge = CreateObject<OffloadTapBridge> ();
+          bridge->SetAttribute ("DeviceName", StringValue (tapNames[i]));
+          bridge->SetAttribute ("MaxUnitSize", UintegerValue (inetMtu));
+          tapNodes[i]->AddDevice (bridge);
+          bridge->SetBridgedNetDevice (csmaDevices.Get (i));
+          offloadBridges.push_back (bridge);
+        }
+    }
+  else
+    {
+      TapBridgeHelper tapBridge;
+      tapBridge.SetAttribute ("Mode", StringValue ("UseBridge"));
+      tapBridge.SetAttribute ("DeviceName", StringValue ("tap-left"));
+      tapBridge.Install (ghostNodes.Get (0), csmaDevices.Get (0));
+
+      tapBridge.SetAttribute ("DeviceName", StringValue ("tap-right"));
+      tapBridge.Install (ghostNodes.Get (1), csmaDevices.Get (1));
 
-  tapBridge.SetAttribute ("DeviceName", StringValue ("tap-server"));
-  tapBridge.Install (remoteHostContainer.Get (1), csmaDevices.Get (2));
+      tapBridge.SetAttribute ("DeviceName", StringValue ("tap-server"));
+      tapBridge.Install (remoteHostContainer.Get (1), csmaDevices.Get (2));
+    }
 
   //internetStackHelper.EnablePcapIpv4 ("prefix", NodeContainer::GetGlobal ());
 
@@ -319,7 +743,19 @@ staticRoutingUeNode0->AddHostRouteTo(Ipv4Address ("10.1.1.1"), Ipv4Address ("7.0
 //
 
   NS_LOG_INFO ("Run Simulation.");
-  csmaHelper.EnablePcapAll ("5gEmu", true);
+  if (lowMemory)
+    {
+      // a single promiscuous capture already sees the whole CSMA segment
+      csmaHelper.EnablePcap ("5gEmu", csmaDevices.Get (0), true);
+    }
+  else
+    {
+      csmaHelper.EnablePcapAll ("5gEmu", true);
+    }
+  if (!memoryReport.empty ())
+    {
+      Simulator::ScheduleNow (&SampleMemory, memorySampleInterval);
+    }
 
   auto start = std::chrono::high_resolution_clock::now ();
 
@@ -331,6 +767,28 @@ staticRoutingUeNode0->AddHostRouteTo(Ipv4Address ("10.1.1.1"), Ipv4Address ("7.0
   auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds> (end - start);
   NS_LOG_INFO ("Real time: " << elapsed.count () << " ms");
   NS_LOG_INFO ("Simulation time: " << (Simulator::Now ()).GetMilliSeconds () << " ms");
+  if (!memoryReport.empty ())
+    {
+      LogMemoryReport ();
+    }
+  for (uint32_t i = 0; i < offloadBridges.size (); ++i)
+    {
+      NS_LOG_UNCOND ("Offload " << tapNames[i] << ": " << offloadBridges[i]->GetFramesRead ()
+                                << " frames from the tap became "
+                                << offloadBridges[i]->GetPacketsSent () << " simulated packets, "
+                                << offloadBridges[i]->GetFramesDropped () << " dropped");
+    }
+  if (timeDilation > 0)
+    {
+      Ptr<EmuSimulatorImpl> impl =
+          DynamicCast<EmuSimulatorImpl> (Simulator::GetImplementation ());
+      NS_LOG_UNCOND ("Time dilation " << timeDilation);
+      NS_LOG_UNCOND ("\tevents fell behind by up to " << impl->GetMaxSlip ().GetMicroSeconds ()
+                                                     << " us");
+      NS_LOG_UNCOND ("\tsmallest dilation within the " << slipBudget.GetMicroSeconds ()
+                                                      << " us slip budget: "
+                                                      << impl->GetMinimumDilation (slipBudget));
+    }
   Simulator::Destroy ();
   NS_LOG_INFO ("Done.");
 }
@@ -0,0 +1,757 @@
+#ifndef EMU_SIMULATOR_IMPL_H
+#define EMU_SIMULATOR_IMPL_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ns3/core-module.h"
+
+//
+// Simulator implementation used by the emulation scenarios.  It forwards every
+// call to a regular implementation (the realtime one for the tap scenarios, the
+// default one otherwise).  With TrackPending (the default) it wraps each
+// scheduled event, so the scenario can see which subsystem scheduled the work
+// that is pending in the event queue.  Events that no feature needs are passed
+// through unwrapped.
+//
+// Bind it before anything touches the simulator:
+//
+//   Config::SetDefault ("ns3::EmuSimulatorImpl::Impl", StringValue ("ns3::RealtimeSimulatorImpl"));
+//   GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::EmuSimulatorImpl"));
+//
+// The subsystem of an event is derived from the type of the object its callback
+// is bound to (see EmuSimulatorImpl::Classify), e.g. ns3::NrGnbPhy -> "nr-phy".
+//
+// With TimeDilation k > 0 it also paces the events of the default
+// implementation against the wall clock: an event at simulation time t runs no
+// earlier than k * t after Run started, so simulated time advances at 1/k of
+// wall-clock time.  Events scheduled from other threads (tap readers) are picked
+// up at the latest one DilationQuantum later.  The wall time spent running the
+// events is recorded per quantum, which gives the smallest k that would have
+// kept the run within a slip budget (GetMinimumDilation).
+//
+// With Profile set it wraps and times every ProfileSampling-th scheduled event,
+// the others run untouched, and charges the wall time to the callback type and
+// the node the event ran on; call counts are extrapolated from the sample.
+// When Run returns it logs the heaviest entries and, if ProfileFolded names a
+// file, writes them as folded stacks (subsystem;callback;node microseconds)
+// for flamegraph.pl or speedscope.
+//
+
+namespace ns3 {
+
+class EmuSimulatorImpl : public SimulatorImpl
+{
+public:
+  static TypeId GetTypeId ();
+
+  EmuSimulatorImpl ();
+  ~EmuSimulatorImpl () override;
+
+  // Events waiting in the queue, per subsystem
+  std::map<std::string, uint64_t> GetPendingEvents () const;
+  // Wrapped events waiting in the queue, all of them with TrackPending
+  uint64_t GetPendingEventCount () const;
+
+  // Subsystem and callback type of an event
+  struct EventClass
+  {
+    std::string subsystem;
+    std::string label;
+  };
+  static const EventClass &Classify (const EventImpl *event);
+
+  // Largest delay of an event behind its dilated wall-clock time
+  Time GetMaxSlip () const;
+  // Smallest dilation that keeps every event within budget of its wall-clock
+  // time, given the event processing times measured in this run
+  double GetMinimumDilation (const Time &budget) const;
+
+  // Wall time of the events per callback type and node
+  struct ProfileEntry
+  {
+    const EventClass *eventClass;
+    uint32_t context;
+    // calls extrapolated from the timed ones
+    uint64_t calls;
+    uint64_t timedCalls;
+    std::chrono::steady_clock::duration time;
+    // time of all calls, extrapolated from the timed ones
+    double GetSeconds () const;
+  };
+  std::vector<ProfileEntry> GetProfile () const;
+
+  // SimulatorImpl
+  void Destroy () override;
+  bool IsFinished () const override;
+  void Stop () override;
+  void Stop (const Time &delay) override;
+  EventId Schedule (const Time &delay, EventImpl *event) override;
+  void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event) override;
+  EventId ScheduleNow (EventImpl *event) override;
+  EventId ScheduleDestroy (EventImpl *event) override;
+  void Remove (const EventId &id) override;
+  void Cancel (const EventId &id) override;
+  bool IsExpired (const EventId &id) const override;
+  void Run () override;
+  Time Now () const override;
+  Time GetDelayLeft (const EventId &id) const override;
+  Time GetMaximumSimulationTime () const override;
+  void SetScheduler (ObjectFactory schedulerFactory) override;
+  uint32_t GetSystemId () const override;
+  uint32_t GetContext () const override;
+  uint64_t GetEventCount () const override;
+
+protected:
+  void DoDispose () override;
+
+private:
+  class Event : public EventImpl
+  {
+  public:
+    Event (EmuSimulatorImpl *sim, EventImpl *event, bool pending, bool sampled);
+    const EventClass &GetClass () const;
+    // called once the event leaves the queue, whether it ran or not
+    void Retire ();
+
+  protected:
+    void Notify () override;
+
+  private:
+    EmuSimulatorImpl *m_sim;
+    Ptr<EventImpl> m_event;
+    const EventClass *m_class;
+    bool m_pending;
+    bool m_sampled;
+  };
+
+  using Clock = std::chrono::steady_clock;
+
+  Ptr<SimulatorImpl> GetImpl () const;
+  // the event itself when no feature needs to see it
+  EventImpl *Wrap (EventImpl *event, bool pending);
+  // waits for the wall-clock time of the current event
+  void Pace ();
+  void Tick ();
+  void ReportProfile () const;
+
+  struct ProfileKeyHash
+  {
+    size_t
+    operator() (const std::pair<const EventClass *, uint32_t> &key) const
+    {
+      return std::hash<const void *> () (key.first) * 31 + key.second;
+    }
+  };
+
+  double m_dilation;
+  Time m_quantum;
+  Clock::time_point m_wallStart;
+  Clock::duration m_maxSlip;
+  Clock::duration m_busy;
+  // (simulated seconds, busy wall seconds) per quantum
+  std::vector<std::pair<double, double>> m_busyPerQuantum;
+
+  bool m_profile;
+  uint32_t m_profileSampling;
+  std::atomic<uint64_t> m_scheduled;
+  std::string m_profileFolded;
+  std::unordered_map<std::pair<const EventClass *, uint32_t>, ProfileEntry, ProfileKeyHash>
+      m_profileEntries;
+
+  std::string m_implType;
+  mutable Ptr<SimulatorImpl> m_impl;
+
+  bool m_trackPending;
+  // events are scheduled from the tap reader threads too
+  mutable std::mutex m_mutex;
+  std::map<std::string, uint64_t> m_pending;
+  std::atomic<uint64_t> m_pendingCount;
+};
+
+NS_OBJECT_ENSURE_REGISTERED (EmuSimulatorImpl);
+
+inline TypeId
+EmuSimulatorImpl::GetTypeId ()
+{
+  static TypeId tid =
+      TypeId ("ns3::EmuSimulatorImpl")
+          .SetParent<SimulatorImpl> ()
+          .AddConstructor<EmuSimulatorImpl> ()
+          .AddAttribute ("Impl", "TypeId of the simulator implementation that runs the events",
+                         StringValue ("ns3::DefaultSimulatorImpl"),
+                         MakeStringAccessor (&EmuSimulatorImpl::m_implType),
+                         MakeStringChecker ())
+          .AddAttribute ("TimeDilation",
+                         "Wall-clock seconds per simulated second, 0 disables pacing.  Use it "
+                         "with the default implementation as Impl",
+                         DoubleValue (0), MakeDoubleAccessor (&EmuSimulatorImpl::m_dilation),
+                         MakeDoubleChecker<double> (0))
+          .AddAttribute ("DilationQuantum",
+                         "Simulated time between pacing points, bounds how late events "
+                         "from other threads are picked up",
+                         TimeValue (MicroSeconds (500)),
+                         MakeTimeAccessor (&EmuSimulatorImpl::m_quantum),
+                         MakeTimeChecker (NanoSeconds (1)))
+          .AddAttribute ("Profile", "Attribute the wall time of the events to callback and node",
+                         BooleanValue (false), MakeBooleanAccessor (&EmuSimulatorImpl::m_profile),
+                         MakeBooleanChecker ())
+          .AddAttribute ("ProfileSampling",
+                         "Wrap and time one in this many scheduled events, the others run "
+                         "without any profiling overhead",
+                         UintegerValue (1),
+                         MakeUintegerAccessor (&EmuSimulatorImpl::m_profileSampling),
+                         MakeUintegerChecker<uint32_t> (1))
+          .AddAttribute ("ProfileFolded", "File for the profile as folded stacks (empty disables)",
+                         StringValue (""),
+                         MakeStringAccessor (&EmuSimulatorImpl::m_profileFolded),
+                         MakeStringChecker ())
+          .AddAttribute ("TrackPending",
+                         "Wrap every event to count the pending ones per subsystem "
+                         "(GetPendingEvents)",
+                         BooleanValue (true),
+                         MakeBooleanAccessor (&EmuSimulatorImpl::m_trackPending),
+                         MakeBooleanChecker ());
+  return tid;
+}
+
+inline EmuSimulatorImpl::EmuSimulatorImpl ()
+    : m_dilation (0),
+      m_maxSlip (Clock::duration::zero ()),
+      m_busy (Clock::duration::zero ()),
+      m_profile (false),
+      m_profileSampling (1),
+      m_scheduled (0),
+      m_trackPending (true),
+      m_pendingCount (0)
+{
+}
+
+inline EmuSimulatorImpl::~EmuSimulatorImpl ()
+{
+}
+
+inline void
+EmuSimulatorImpl::DoDispose ()
+{
+  m_impl = nullptr;
+  SimulatorImpl::DoDispose ();
+}
+
+inline Ptr<SimulatorImpl>
+EmuSimulatorImpl::GetImpl () const
+{
+  // created lazily because the attributes are only set after construction
+  if (!m_impl)
+    {
+      ObjectFactory factory;
+      factory.SetTypeId (m_implType);
+      m_impl = factory.Create<SimulatorImpl> ();
+    }
+  return m_impl;
+}
+
+inline const EmuSimulatorImpl::EventClass &
+EmuSimulatorImpl::Classify (const EventImpl *event)
+{
+  // substring of the callback's object type -> subsystem, first match wins.
+  // Applications come first, their names contain protocol names (UdpClient).
+  static const std::pair<const char *, const char *> rules[] = {
+      {"UdpClient", "applications"}, {"UdpServer", "applications"},
+      {"UdpEcho", "applications"},   {"UdpTrace", "applications"},
+      {"OnOff", "applications"},     {"BulkSend", "applications"},
+      {"PacketSink", "applications"}, {"Ping", "applications"},
+      {"Application", "applications"}, {"TapBridge", "tap-bridge"},
+      {"Csma", "csma"},              {"PointToPoint", "p2p"},
+      {"Spectrum", "nr-phy"},        {"ThreeGpp", "nr-phy"},
+      {"Phy", "nr-phy"},             {"NrMacScheduler", "nr-mac"},
+      {"Mac", "nr-mac"},             {"Rlc", "rlc"},
+      {"Pdcp", "pdcp"},              {"Rrc", "rrc"},
+      {"Epc", "epc"},                {"Gtp", "epc"},
+      {"Pcap", "trace"},             {"Trace", "trace"},
+      {"Ipv4", "internet"},          {"Arp", "internet"},
+      {"Tcp", "internet"},           {"Udp", "internet"},
+      {"Mobility", "mobility"},
+  };
+  // Each thread looks the type up in its own cache first, so only the first
+  // event of a type on a thread takes the lock.  Elements of the shared map
+  // never move, the per-thread caches point into it.
+  static std::mutex mutex;
+  static std::unordered_map<std::type_index, EventClass> cache;
+  static thread_local std::unordered_map<std::type_index, const EventClass *> local;
+
+  std::type_index type (typeid (*event));
+  auto known = local.find (type);
+  if (known != local.end ())
+    {
+      return *known->second;
+    }
+  std::lock_guard<std::mutex> lock (mutex);
+  auto it = cache.find (type);
+  if (it != cache.end ())
+    {
+      local.emplace (type, &it->second);
+      return it->second;
+    }
+
+  int status = 0;
+  char *demangled = abi::__cxa_demangle (type.name (), nullptr, nullptr, &status);
+  std::string name = status == 0 ? demangled : type.name ();
+  std::free (demangled);
+
+  // MakeEvent on a member function: "ns3::MakeEvent<void (ns3::NrGnbPhy::*)(...), ...>"
+  // is labelled with the class, on a plain function with its signature
+  EventClass eventClass;
+  std::string::size_type member = name.find ("::*)");
+  std::string::size_type function = name.find ("(*)(");
+  if (member != std::string::npos)
+    {
+      std::string::size_type open = name.rfind ('(', member);
+      eventClass.label = name.substr (open + 1, member - open - 1);
+    }
+  else if (function != std::string::npos && name.find ('<') < function)
+    {
+      std::string::size_type begin = name.find ('<') + 1;
+      eventClass.label = name.substr (begin, name.find (')', function + 4) + 1 - begin);
+    }
+  else
+    {
+      eventClass.label = name.substr (0, name.find ('<'));
+    }
+  eventClass.subsystem = "other";
+  for (const auto &rule : rules)
+    {
+      if (eventClass.label.find (rule.first) != std::string::npos)
+        {
+          eventClass.subsystem = rule.second;
+          break;
+        }
+    }
+  const EventClass &added = cache.emplace (type, eventClass).first->second;
+  local.emplace (type, &added);
+  return added;
+}
+
+inline EmuSimulatorImpl::Event::Event (EmuSimulatorImpl *sim, EventImpl *event, bool pending,
+                                       bool sampled)
+    : m_sim (sim),
+      m_event (event, false),
+      m_class (&Classify (event)),
+      m_pending (pending),
+      m_sampled (sampled)
+{
+}
+
+inline const EmuSimulatorImpl::EventClass &
+EmuSimulatorImpl::Event::GetClass () const
+{
+  return *m_class;
+}
+
+inline void
+EmuSimulatorImpl::Event::Retire ()
+{
+  if (!m_pending)
+    {
+      return;
+    }
+  m_pending = false;
+  --m_sim->m_pendingCount;
+  if (m_sim->m_trackPending)
+    {
+      std::lock_guard<std::mutex> lock (m_sim->m_mutex);
+      --m_sim->m_pending[m_class->subsystem];
+    }
+}
+
+inline void
+EmuSimulatorImpl::Event::Notify ()
+{
+  Retire ();
+  EmuSimulatorImpl *sim = m_sim;
+  if (sim->m_dilation > 0)
+    {
+      sim->Pace ();
+    }
+  else if (!m_sampled)
+    {
+      m_event->Invoke ();
+      return;
+    }
+  Clock::time_point start = Clock::now ();
+  m_event->Invoke ();
+  Clock::duration elapsed = Clock::now () - start;
+  if (sim->m_dilation > 0)
+    {
+      sim->m_busy += elapsed;
+    }
+  if (m_sampled)
+    {
+      uint32_t context = sim->GetContext ();
+      ProfileEntry &entry = sim->m_profileEntries[{m_class, context}];
+      entry.eventClass = m_class;
+      entry.context = context;
+      entry.calls += sim->m_profileSampling;
+      ++entry.timedCalls;
+      entry.time += elapsed;
+    }
+}
+
+inline EventImpl *
+EmuSimulatorImpl::Wrap (EventImpl *event, bool pending)
+{
+  bool sampled = m_profile && m_scheduled++ % m_profileSampling == 0;
+  if (!sampled && !m_trackPending && m_dilation <= 0)
+    {
+      return event;
+    }
+  Event *wrapped = new Event (this, event, pending, sampled);
+  if (pending)
+    {
+      ++m_pendingCount;
+      if (m_trackPending)
+        {
+          std::lock_guard<std::mutex> lock (m_mutex);
+          ++m_pending[wrapped->GetClass ().subsystem];
+        }
+    }
+  return wrapped;
+}
+
+inline void
+EmuSimulatorImpl::Pace ()
+{
+  Clock::time_point target =
+      m_wallStart + std::chrono::duration_cast<Clock::duration> (
+                        std::chrono::duration<double> (m_dilation * Now ().GetSeconds ()));
+  Clock::time_point now = Clock::now ();
+  if (now < target)
+    {
+      std::this_thread::sleep_until (target);
+    }
+  else
+    {
+      m_maxSlip = std::max (m_maxSlip, now - target);
+    }
+}
+
+inline void
+EmuSimulatorImpl::Tick ()
+{
+  Pace ();
+  m_busyPerQuantum.emplace_back (m_quantum.GetSeconds (),
+                                 std::chrono::duration<double> (m_busy).count ());
+  m_busy = Clock::duration::zero ();
+  // keep ticking only while there is work, so the run can still end on its own
+  if (m_pendingCount > 0)
+    {
+      GetImpl ()->Schedule (m_quantum, MakeEvent (&EmuSimulatorImpl::Tick, this));
+    }
+}
+
+inline Time
+EmuSimulatorImpl::GetMaxSlip () const
+{
+  return NanoSeconds (std::chrono::duration_cast<std::chrono::nanoseconds> (m_maxSlip).count ());
+}
+
+inline double
+EmuSimulatorImpl::GetMinimumDilation (const Time &budget) const
+{
+  // Paced at k, a quantum whose events take longer than k times its length
+  // pushes the following ones late, and idle time absorbs the backlog again.
+  auto worstSlip = [this] (double k) {
+    double late = 0;
+    double worst = 0;
+    for (const auto &quantum : m_busyPerQuantum)
+      {
+        late = std::max (0.0, late + quantum.second - k * quantum.first);
+        worst = std::max (worst, late);
+      }
+    return worst;
+  };
+  double limit = budget.GetSeconds ();
+  double low = 0;
+  double high = 1;
+  while (worstSlip (high) > limit && high < 1e6)
+    {
+      low = high;
+      high *= 2;
+    }
+  for (int i = 0; i < 50; ++i)
+    {
+      double mid = (low + high) / 2;
+      (worstSlip (mid) > limit ? low : high) = mid;
+    }
+  return high;
+}
+
+inline double
+EmuSimulatorImpl::ProfileEntry::GetSeconds () const
+{
+  if (timedCalls == 0)
+    {
+      return 0;
+    }
+  return std::chrono::duration<double> (time).count () * calls / timedCalls;
+}
+
+inline std::vector<EmuSimulatorImpl::ProfileEntry>
+EmuSimulatorImpl::GetProfile () const
+{
+  std::vector<ProfileEntry> entries;
+  for (const auto &entry : m_profileEntries)
+    {
+      entries.push_back (entry.second);
+    }
+  std::sort (entries.begin (), entries.end (),
+             [] (const ProfileEntry &a, const ProfileEntry &b) {
+               return a.GetSeconds () > b.GetSeconds ();
+             });
+  return entries;
+}
+
+inline void
+EmuSimulatorImpl::ReportProfile () const
+{
+  std::vector<ProfileEntry> entries = GetProfile ();
+  double total = 0;
+  uint64_t calls = 0;
+  std::map<std::string, std::pair<double, uint64_t>> subsystems;
+  for (const ProfileEntry &entry : entries)
+    {
+      total += entry.GetSeconds ();
+      calls += entry.calls;
+      subsystems[entry.eventClass->subsystem].first += entry.GetSeconds ();
+      subsystems[entry.eventClass->subsystem].second += entry.calls;
+    }
+  std::vector<std::pair<double, std::string>> bySubsystem;
+  for (const auto &subsystem : subsystems)
+    {
+      bySubsystem.emplace_back (subsystem.second.first, subsystem.first);
+    }
+  std::sort (bySubsystem.rbegin (), bySubsystem.rend ());
+
+  auto node = [] (uint32_t context) {
+    return context == 0xffffffff ? std::string ("-") : std::to_string (context);
+  };
+  std::ostringstream out;
+  out << "Event profile: " << calls << " events, " << std::fixed << std::setprecision (3) << total
+      << " s";
+  if (m_profileSampling > 1)
+    {
+      out << " (1 in " << m_profileSampling << " timed)";
+    }
+  out << "\n";
+  for (const auto &subsystem : bySubsystem)
+    {
+      out << "\t" << std::setw (12) << std::left << subsystem.second << std::right
+          << std::setw (10) << subsystem.first << " s " << std::setw (6) << std::setprecision (1)
+          << (total > 0 ? 100 * subsystem.first / total : 0) << "% " << std::setw (12)
+          << subsystems[subsystem.second].second << " calls\n"
+          << std::setprecision (3);
+    }
+  out << "\theaviest callbacks (node, calls, s, us/call):\n";
+  for (size_t i = 0; i < entries.size () && i < 30; ++i)
+    {
+      const ProfileEntry &entry = entries[i];
+      out << "\t\t" << entry.eventClass->label << " [" << entry.eventClass->subsystem << "] node "
+          << node (entry.context) << ": " << entry.calls << ", " << entry.GetSeconds () << ", "
+          << std::setprecision (2) << 1e6 * entry.GetSeconds () / entry.calls << "\n"
+          << std::setprecision (3);
+    }
+  // through the same stream as the scenario's own reports, without the last newline
+  std::string report = out.str ();
+  report.pop_back ();
+  NS_LOG_UNCOND (report);
+
+  if (!m_profileFolded.empty ())
+    {
+      std::ofstream folded (m_profileFolded);
+      for (const ProfileEntry &entry : entries)
+        {
+          std::string label = entry.eventClass->label;
+          std::replace (label.begin (), label.end (), ';', ',');
+          folded << entry.eventClass->subsystem << ";" << label << ";node "
+                 << node (entry.context) << " "
+                 << static_cast<uint64_t> (1e6 * entry.GetSeconds ()) << "\n";
+        }
+    }
+}
+
+inline std::map<std::string, uint64_t>
+EmuSimulatorImpl::GetPendingEvents () const
+{
+  std::lock_guard<std::mutex> lock (m_mutex);
+  return m_pending;
+}
+
+inline uint64_t
+EmuSimulatorImpl::GetPendingEventCount () const
+{
+  return m_pendingCount;
+}
+
+inline void
+EmuSimulatorImpl::Destroy ()
+{
+  GetImpl ()->Destroy ();
+}
+
+inline bool
+EmuSimulatorImpl::IsFinished () const
+{
+  return GetImpl ()->IsFinished ();
+}
+
+inline void
+EmuSimulatorImpl::Stop ()
+{
+  GetImpl ()->Stop ();
+}
+
+inline void
+EmuSimulatorImpl::Stop (const Time &delay)
+{
+  GetImpl ()->Stop (delay);
+}
+
+inline EventId
+EmuSimulatorImpl::Schedule (const Time &delay, EventImpl *event)
+{
+  return GetImpl ()->Schedule (delay, Wrap (event, true));
+}
+
+inline void
+EmuSimulatorImpl::ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event)
+{
+  GetImpl ()->ScheduleWithContext (context, delay, Wrap (event, true));
+}
+
+inline EventId
+EmuSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  return GetImpl ()->ScheduleNow (Wrap (event, true));
+}
+
+inline EventId
+EmuSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  return GetImpl ()->ScheduleDestroy (Wrap (event, false));
+}
+
+inline void
+EmuSimulatorImpl::Remove (const EventId &id)
+{
+  Event *wrapped = dynamic_cast<Event *> (id.PeekEventImpl ());
+  if (wrapped && !GetImpl ()->IsExpired (id))
+    {
+      wrapped->Retire ();
+    }
+  GetImpl ()->Remove (id);
+}
+
+inline void
+EmuSimulatorImpl::Cancel (const EventId &id)
+{
+  Event *wrapped = dynamic_cast<Event *> (id.PeekEventImpl ());
+  if (wrapped && !GetImpl ()->IsExpired (id))
+    {
+      wrapped->Retire ();
+    }
+  GetImpl ()->Cancel (id);
+}
+
+inline bool
+EmuSimulatorImpl::IsExpired (const EventId &id) const
+{
+  return GetImpl ()->IsExpired (id);
+}
+
+inline void
+EmuSimulatorImpl::Run ()
+{
+  if (m_dilation > 0)
+    {
+      m_wallStart = Clock::now () - std::chrono::duration_cast<Clock::duration> (
+                                        std::chrono::duration<double> (
+                                            m_dilation * GetImpl ()->Now ().GetSeconds ()));
+      GetImpl ()->ScheduleNow (MakeEvent (&EmuSimulatorImpl::Tick, this));
+    }
+  GetImpl ()->Run ();
+  if (m_profile)
+    {
+      ReportProfile ();
+    }
+}
+
+inline Time
+EmuSimulatorImpl::Now () const
+{
+  return GetImpl ()->Now ();
+}
+
+inline Time
+EmuSimulatorImpl::GetDelayLeft (const EventId &id) const
+{
+  return GetImpl ()->GetDelayLeft (id);
+}
+
+inline Time
+EmuSimulatorImpl::GetMaximumSimulationTime () const
+{
+  return GetImpl ()->GetMaximumSimulationTime ();
+}
+
+inline void
+EmuSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
+{
+  GetImpl ()->SetScheduler (schedulerFactory);
+}
+
+inline uint32_t
+EmuSimulatorImpl::GetSystemId () const
+{
+  return GetImpl ()->GetSystemId ();
+}
+
+inline uint32_t
+EmuSimulatorImpl::GetContext () const
+{
+  return GetImpl ()->GetContext ();
+}
+
+inline uint64_t
+EmuSimulatorImpl::GetEventCount () const
+{
+  return GetImpl ()->GetEventCount ();
+}
+
+} // namespace ns3
+
+#endif /* EMU_SIMULATOR_IMPL_H */
+/*
+ * ns3 network simulator code
+ * Copyright 2023 Carnegie Mellon University.
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * Released under a MIT (SEI)-style license, please see license.txt or contact permission@sei.cmu.edu for full terms.
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release and unlimited distribution.  Please see Copyright notice for non-US Government use and distribution.
+ * This Software includes and/or makes use of the following Third-Party Software subject to its own license:
+ * 1. ns-3 (https://www.nsnam.org/about/) Copyright 2011 nsnam.
+ * DM23-0109
+ */
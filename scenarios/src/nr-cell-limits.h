@@ -0,0 +1,45 @@
+#ifndef NR_CELL_LIMITS_H
+#define NR_CELL_LIMITS_H
+
+#include <cstdint>
+#include <initializer_list>
+
+//
+// Cell sizing shared by the NR scenarios, so the emulation and the benchmark
+// configure a cell of the same size the same way.
+//
+
+namespace ns3 {
+
+// The RRC gives every UE of a cell its own SRS offset and the largest SRS
+// periodicity has 320 of them, one of which stays unused
+static const uint32_t MAX_UES_PER_CELL = 320;
+
+// Smallest SRS periodicity with an offset for each of uesPerCell UEs, starting
+// at the LTE RRC default of 40
+inline uint32_t
+SrsPeriodicityFor (uint32_t uesPerCell)
+{
+  for (uint32_t periodicity : {40, 80, 160, 320})
+    {
+      if (periodicity > uesPerCell)
+        {
+          return periodicity;
+        }
+    }
+  return MAX_UES_PER_CELL;
+}
+
+} // namespace ns3
+
+#endif /* NR_CELL_LIMITS_H */
+/*
+ * ns3 network simulator code
+ * Copyright 2023 Carnegie Mellon University.
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * Released under a MIT (SEI)-style license, please see license.txt or contact permission@sei.cmu.edu for full terms.
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release and unlimited distribution.  Please see Copyright notice for non-US Government use and distribution.
+ * This Software includes and/or makes use of the following Third-Party Software subject to its own license:
+ * 1. ns-3 (https://www.nsnam.org/about/) Copyright 2011 nsnam.
+ * DM23-0109
+ */
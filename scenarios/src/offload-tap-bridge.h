@@ -0,0 +1,708 @@
+#ifndef OFFLOAD_TAP_BRIDGE_H
+#define OFFLOAD_TAP_BRIDGE_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/if_tun.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/fd-reader.h"
+
+//
+// Drop-in for TapBridge in UseBridge mode that uses the offloads of the tap
+// device.  It opens the existing tap with a virtio-net header (IFF_VNET_HDR)
+// and advertises checksum and TSO offload, so the kernel hands over the TCP
+// super-frames of the containers (up to 64 KiB) instead of one frame per MSS.
+//
+// Ingress, a super-frame is cut into TCP segments of MaxUnitSize bytes of IP
+// packet, the largest unit every link of the scenario carries without IP
+// fragmentation (the 2500-byte p2p MTU in cttc), rather than into the MSS of
+// the container.  Partial checksums left by the kernel are completed.
+// Egress, TCP packets larger than EgressMtu are written with a GSO header, and
+// the kernel cuts them down to the MTU of the container.
+//
+// The bridged device must accept frames of MaxUnitSize, e.g. a CSMA device with
+// its Mtu attribute raised to match.
+//
+//   Ptr<OffloadTapBridge> bridge = CreateObject<OffloadTapBridge> ();
+//   bridge->SetAttribute ("DeviceName", StringValue ("tap-left"));
+//   ghostNode->AddDevice (bridge);
+//   bridge->SetBridgedNetDevice (csmaDevice);
+//
+
+namespace ns3 {
+
+namespace offload {
+
+const uint16_t ETHERNET_HEADER = 14;
+const uint16_t ETHERTYPE_IPV4 = 0x0800;
+const uint8_t PROTOCOL_TCP = 6;
+
+// struct virtio_net_hdr, <linux/virtio_net.h> does not compile as C++.  The
+// fields are in host byte order.
+struct VirtioNetHeader
+{
+  uint8_t flags;
+  uint8_t gsoType;
+  uint16_t hdrLen;
+  uint16_t gsoSize;
+  uint16_t csumStart;
+  uint16_t csumOffset;
+};
+const uint8_t VIRTIO_NET_HDR_F_NEEDS_CSUM = 1;
+const uint8_t VIRTIO_NET_HDR_GSO_NONE = 0;
+const uint8_t VIRTIO_NET_HDR_GSO_TCPV4 = 1;
+
+inline uint16_t
+Read16 (const uint8_t *p)
+{
+  return (p[0] << 8) | p[1];
+}
+
+inline void
+Write16 (uint8_t *p, uint16_t value)
+{
+  p[0] = value >> 8;
+  p[1] = value & 0xff;
+}
+
+inline uint32_t
+Read32 (const uint8_t *p)
+{
+  return (uint32_t (p[0]) << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+inline void
+Write32 (uint8_t *p, uint32_t value)
+{
+  Write16 (p, value >> 16);
+  Write16 (p + 2, value & 0xffff);
+}
+
+// Internet checksum arithmetic: one's complement sum, folded to 16 bits
+inline uint32_t
+Sum (const uint8_t *data, size_t len, uint32_t sum = 0)
+{
+  for (size_t i = 0; i + 1 < len; i += 2)
+    {
+      sum += Read16 (data + i);
+    }
+  if (len & 1)
+    {
+      sum += data[len - 1] << 8;
+    }
+  return sum;
+}
+
+inline uint16_t
+Fold (uint32_t sum)
+{
+  while (sum >> 16)
+    {
+      sum = (sum & 0xffff) + (sum >> 16);
+    }
+  return sum;
+}
+
+// Sum of the IPv4 pseudo header for a TCP segment of tcpLen bytes
+inline uint32_t
+PseudoHeaderSum (const uint8_t *ip, uint16_t tcpLen)
+{
+  return Sum (ip + 12, 8) + PROTOCOL_TCP + tcpLen;
+}
+
+// Offsets of the headers of an Ethernet/IPv4/TCP frame, false for other frames
+struct TcpFrame
+{
+  uint16_t ipHeader;
+  uint16_t tcpHeader;
+  uint16_t headers; // Ethernet, IP and TCP
+};
+
+inline bool
+ParseTcp (const uint8_t *frame, size_t len, TcpFrame *out)
+{
+  if (len < ETHERNET_HEADER + 20 || Read16 (frame + 12) != ETHERTYPE_IPV4)
+    {
+      return false;
+    }
+  const uint8_t *ip = frame + ETHERNET_HEADER;
+  out->ipHeader = (ip[0] & 0x0f) * 4;
+  if ((ip[0] >> 4) != 4 || out->ipHeader < 20 || ip[9] != PROTOCOL_TCP ||
+      len < ETHERNET_HEADER + out->ipHeader + 20u)
+    {
+      return false;
+    }
+  out->tcpHeader = (ip[out->ipHeader + 12] >> 4) * 4;
+  out->headers = ETHERNET_HEADER + out->ipHeader + out->tcpHeader;
+  return out->tcpHeader >= 20 && len >= out->headers;
+}
+
+// Finishes a checksum the kernel left partial (VIRTIO_NET_HDR_F_NEEDS_CSUM):
+// the field holds the pseudo header sum, the data from start on is missing
+inline void
+CompleteChecksum (uint8_t *frame, size_t len, uint16_t start, uint16_t offset)
+{
+  if (start + offset + 2u > len)
+    {
+      return;
+    }
+  Write16 (frame + start + offset, ~Fold (Sum (frame + start, len - start)));
+}
+
+// Cuts an Ethernet/IPv4/TCP frame into frames whose IP packets are at most
+// maxUnit bytes, with the sequence numbers, IP IDs, flags and checksums of
+// the segments a TSO engine would have produced.  Frames that fit come back
+// unchanged apart from complete checksums.
+inline std::vector<std::vector<uint8_t>>
+SegmentTcp (const uint8_t *frame, size_t len, size_t maxUnit)
+{
+  std::vector<std::vector<uint8_t>> segments;
+  TcpFrame tcp;
+  if (!ParseTcp (frame, len, &tcp) || maxUnit <= tcp.ipHeader + tcp.tcpHeader)
+    {
+      return segments;
+    }
+  size_t payload = len - tcp.headers;
+  size_t mss = maxUnit - tcp.ipHeader - tcp.tcpHeader;
+  const uint8_t *ip = frame + ETHERNET_HEADER;
+  uint16_t id = Read16 (ip + 4);
+  uint32_t seq = Read32 (ip + tcp.ipHeader + 4);
+  uint8_t flags = ip[tcp.ipHeader + 13];
+  for (size_t offset = 0; offset < payload || segments.empty (); offset += mss)
+    {
+      size_t chunk = std::min (mss, payload - offset);
+      std::vector<uint8_t> segment (tcp.headers + chunk);
+      std::memcpy (segment.data (), frame, tcp.headers);
+      std::memcpy (segment.data () + tcp.headers, frame + tcp.headers + offset, chunk);
+
+      uint8_t *sip = segment.data () + ETHERNET_HEADER;
+      uint8_t *sth = sip + tcp.ipHeader;
+      uint16_t tcpLen = tcp.tcpHeader + chunk;
+      Write16 (sip + 2, tcp.ipHeader + tcpLen);
+      Write16 (sip + 4, id + segments.size ());
+      Write16 (sip + 10, 0);
+      Write16 (sip + 10, ~Fold (Sum (sip, tcp.ipHeader)));
+
+      Write32 (sth + 4, seq + offset);
+      bool last = offset + chunk >= payload;
+      // FIN and PSH belong to the last segment, CWR to the first
+      sth[13] = flags & ~(last ? 0 : 0x09) & ~(segments.empty () ? 0 : 0x80);
+      Write16 (sth + 16, 0);
+      Write16 (sth + 16, ~Fold (Sum (sth, tcpLen, PseudoHeaderSum (sip, tcpLen))));
+      segments.push_back (std::move (segment));
+    }
+  return segments;
+}
+
+// Virtio header for a frame going to the tap.  A TCP packet larger than mtu
+// becomes a GSO frame with a partial checksum, which the kernel segments.
+inline VirtioNetHeader
+EgressHeader (uint8_t *frame, size_t len, size_t mtu)
+{
+  VirtioNetHeader header = {};
+  header.gsoType = VIRTIO_NET_HDR_GSO_NONE;
+  TcpFrame tcp;
+  if (len - ETHERNET_HEADER <= mtu || !ParseTcp (frame, len, &tcp) ||
+      mtu <= tcp.ipHeader + tcp.tcpHeader)
+    {
+      return header;
+    }
+  uint8_t *ip = frame + ETHERNET_HEADER;
+  uint16_t tcpLen = len - ETHERNET_HEADER - tcp.ipHeader;
+  header.flags = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+  header.gsoType = VIRTIO_NET_HDR_GSO_TCPV4;
+  header.hdrLen = tcp.headers;
+  header.gsoSize = mtu - tcp.ipHeader - tcp.tcpHeader;
+  header.csumStart = ETHERNET_HEADER + tcp.ipHeader;
+  header.csumOffset = 16;
+  Write16 (ip + tcp.ipHeader + 16, Fold (PseudoHeaderSum (ip, tcpLen)));
+  return header;
+}
+
+} // namespace offload
+
+class OffloadTapBridge : public NetDevice
+{
+public:
+  static TypeId GetTypeId ();
+
+  OffloadTapBridge ();
+  ~OffloadTapBridge () override;
+
+  void SetBridgedNetDevice (Ptr<NetDevice> bridgedDevice);
+  Ptr<NetDevice> GetBridgedNetDevice () const;
+
+  // Frames read from the tap and the simulated packets they became
+  uint64_t GetFramesRead () const;
+  uint64_t GetPacketsSent () const;
+  // Frames that could not be forwarded: truncated reads and frames larger
+  // than MaxUnitSize that are not TCP over IPv4, so cannot be segmented
+  uint64_t GetFramesDropped () const;
+
+  // NetDevice, like TapBridge in UseBridge mode the node cannot send on it
+  void SetIfIndex (const uint32_t index) override;
+  uint32_t GetIfIndex () const override;
+  Ptr<Channel> GetChannel () const override;
+  void SetAddress (Address address) override;
+  Address GetAddress () const override;
+  bool SetMtu (const uint16_t mtu) override;
+  uint16_t GetMtu () const override;
+  bool IsLinkUp () const override;
+  void AddLinkChangeCallback (Callback<void> callback) override;
+  bool IsBroadcast () const override;
+  Address GetBroadcast () const override;
+  bool IsMulticast () const override;
+  Address GetMulticast (Ipv4Address multicastGroup) const override;
+  Address GetMulticast (Ipv6Address addr) const override;
+  bool IsPointToPoint () const override;
+  bool IsBridge () const override;
+  bool Send (Ptr<Packet> packet, const Address &dest, uint16_t protocolNumber) override;
+  bool SendFrom (Ptr<Packet> packet, const Address &source, const Address &dest,
+                 uint16_t protocolNumber) override;
+  Ptr<Node> GetNode () const override;
+  void SetNode (Ptr<Node> node) override;
+  bool NeedsArp () const override;
+  void SetReceiveCallback (NetDevice::ReceiveCallback cb) override;
+  void SetPromiscReceiveCallback (NetDevice::PromiscReceiveCallback cb) override;
+  bool SupportsSendFrom () const override;
+
+protected:
+  void DoDispose () override;
+
+private:
+  class Reader : public FdReader
+  {
+  private:
+    FdReader::Data DoRead () override;
+  };
+
+  void StartTapDevice ();
+  // runs on the reader thread
+  void ReadCallback (uint8_t *buf, ssize_t len);
+  void ForwardToBridgedDevice (uint8_t *buf, ssize_t len);
+  void ReceiveFromBridgedDevice (Ptr<NetDevice> device, Ptr<const Packet> packet,
+                                 uint16_t protocol, const Address &src, const Address &dst,
+                                 NetDevice::PacketType packetType);
+  bool DiscardFromBridgedDevice (Ptr<NetDevice> device, Ptr<const Packet> packet,
+                                 uint16_t protocol, const Address &src);
+
+  std::string m_deviceName;
+  uint32_t m_maxUnitSize;
+  uint32_t m_egressMtu;
+  uint16_t m_mtu;
+
+  Ptr<Node> m_node;
+  uint32_t m_nodeId;
+  uint32_t m_ifIndex;
+  Ptr<NetDevice> m_bridgedDevice;
+  int m_fd;
+  Ptr<Reader> m_reader;
+  uint64_t m_framesRead;
+  uint64_t m_packetsSent;
+  uint64_t m_framesDropped;
+};
+
+NS_OBJECT_ENSURE_REGISTERED (OffloadTapBridge);
+
+inline TypeId
+OffloadTapBridge::GetTypeId ()
+{
+  static TypeId tid =
+      TypeId ("ns3::OffloadTapBridge")
+          .SetParent<NetDevice> ()
+          .AddConstructor<OffloadTapBridge> ()
+          .AddAttribute ("DeviceName", "Name of the existing tap device", StringValue (""),
+                         MakeStringAccessor (&OffloadTapBridge::m_deviceName),
+                         MakeStringChecker ())
+          .AddAttribute ("MaxUnitSize",
+                         "Largest IP packet a TCP super-frame from the tap is cut into",
+                         UintegerValue (1500),
+                         MakeUintegerAccessor (&OffloadTapBridge::m_maxUnitSize),
+                         MakeUintegerChecker<uint32_t> (576, 65535))
+          .AddAttribute ("EgressMtu",
+                         "MTU on the container side, larger TCP packets are written as GSO "
+                         "frames",
+                         UintegerValue (1500),
+                         MakeUintegerAccessor (&OffloadTapBridge::m_egressMtu),
+                         MakeUintegerChecker<uint32_t> (576, 65535))
+          .AddAttribute ("Mtu", "MAC-level Maximum Transmission Unit", UintegerValue (1500),
+                         MakeUintegerAccessor (&OffloadTapBridge::SetMtu,
+                                               &OffloadTapBridge::GetMtu),
+                         MakeUintegerChecker<uint16_t> ());
+  return tid;
+}
+
+inline OffloadTapBridge::OffloadTapBridge ()
+    : m_maxUnitSize (1500),
+      m_egressMtu (1500),
+      m_mtu (1500),
+      m_nodeId (0),
+      m_ifIndex (0),
+      m_fd (-1),
+      m_framesRead (0),
+      m_packetsSent (0),
+      m_framesDropped (0)
+{
+}
+
+inline OffloadTapBridge::~OffloadTapBridge ()
+{
+}
+
+inline void
+OffloadTapBridge::DoDispose ()
+{
+  if (m_reader)
+    {
+      m_reader->Stop ();
+      m_reader = nullptr;
+    }
+  if (m_fd >= 0)
+    {
+      close (m_fd);
+      m_fd = -1;
+    }
+  m_bridgedDevice = nullptr;
+  m_node = nullptr;
+  NetDevice::DoDispose ();
+}
+
+inline void
+OffloadTapBridge::SetBridgedNetDevice (Ptr<NetDevice> bridgedDevice)
+{
+  NS_ABORT_MSG_IF (!m_node, "OffloadTapBridge: add the device to its node first");
+  NS_ABORT_MSG_IF (!bridgedDevice->SupportsSendFrom (),
+                   "OffloadTapBridge: the bridged device must support SendFrom");
+  // the ghost node itself does not take part, every frame goes to the tap
+  bridgedDevice->SetReceiveCallback (
+      MakeCallback (&OffloadTapBridge::DiscardFromBridgedDevice, this));
+  // promiscuous, so frames for the containers' MAC addresses come here too
+  m_node->RegisterProtocolHandler (MakeCallback (&OffloadTapBridge::ReceiveFromBridgedDevice, this),
+                                   0, bridgedDevice, true);
+  m_bridgedDevice = bridgedDevice;
+  Simulator::ScheduleWithContext (m_node->GetId (), Seconds (0),
+                                  &OffloadTapBridge::StartTapDevice, this);
+}
+
+inline Ptr<NetDevice>
+OffloadTapBridge::GetBridgedNetDevice () const
+{
+  return m_bridgedDevice;
+}
+
+inline uint64_t
+OffloadTapBridge::GetFramesRead () const
+{
+  return m_framesRead;
+}
+
+inline uint64_t
+OffloadTapBridge::GetPacketsSent () const
+{
+  return m_packetsSent;
+}
+
+inline uint64_t
+OffloadTapBridge::GetFramesDropped () const
+{
+  return m_framesDropped;
+}
+
+inline void
+OffloadTapBridge::StartTapDevice ()
+{
+  m_fd = open ("/dev/net/tun", O_RDWR | O_CLOEXEC);
+  NS_ABORT_MSG_IF (m_fd < 0, "OffloadTapBridge: cannot open /dev/net/tun: " << std::strerror (errno));
+  ifreq ifr = {};
+  ifr.ifr_flags = IFF_TAP | IFF_NO_PI | IFF_VNET_HDR;
+  std::strncpy (ifr.ifr_name, m_deviceName.c_str (), IFNAMSIZ - 1);
+  NS_ABORT_MSG_IF (ioctl (m_fd, TUNSETIFF, &ifr) < 0,
+                   "OffloadTapBridge: cannot attach to " << m_deviceName << ": "
+                                                         << std::strerror (errno));
+  int headerSize = sizeof (offload::VirtioNetHeader);
+  NS_ABORT_MSG_IF (ioctl (m_fd, TUNSETVNETHDRSZ, &headerSize) < 0,
+                   "OffloadTapBridge: TUNSETVNETHDRSZ: " << std::strerror (errno));
+  // we complete checksums and take TCPv4 super-frames
+  NS_ABORT_MSG_IF (ioctl (m_fd, TUNSETOFFLOAD, TUN_F_CSUM | TUN_F_TSO4) < 0,
+                   "OffloadTapBridge: TUNSETOFFLOAD: " << std::strerror (errno));
+
+  m_nodeId = m_node->GetId ();
+  m_reader = Create<Reader> ();
+  m_reader->Start (m_fd, MakeCallback (&OffloadTapBridge::ReadCallback, this));
+}
+
+inline FdReader::Data
+OffloadTapBridge::Reader::DoRead ()
+{
+  // a 64 KiB super-frame plus its Ethernet and virtio headers
+  const size_t bufferSize = 65536 + 1024;
+  uint8_t *buf = static_cast<uint8_t *> (std::malloc (bufferSize));
+  ssize_t len = read (m_fd, buf, bufferSize);
+  if (len <= 0)
+    {
+      std::free (buf);
+      buf = nullptr;
+      len = 0;
+    }
+  return FdReader::Data (buf, len);
+}
+
+inline void
+OffloadTapBridge::ReadCallback (uint8_t *buf, ssize_t len)
+{
+  Simulator::ScheduleWithContext (m_nodeId, Seconds (0),
+                                  MakeEvent (&OffloadTapBridge::ForwardToBridgedDevice, this,
+                                             buf, len));
+}
+
+inline void
+OffloadTapBridge::ForwardToBridgedDevice (uint8_t *buf, ssize_t len)
+{
+  if (len < ssize_t (sizeof (offload::VirtioNetHeader) + offload::ETHERNET_HEADER))
+    {
+      ++m_framesDropped;
+      std::free (buf);
+      return;
+    }
+  ++m_framesRead;
+  offload::VirtioNetHeader header;
+  std::memcpy (&header, buf, sizeof (header));
+  uint8_t *frame = buf + sizeof (header);
+  size_t frameLen = len - sizeof (header);
+
+  std::vector<std::vector<uint8_t>> frames;
+  if (header.gsoType != offload::VIRTIO_NET_HDR_GSO_NONE ||
+      frameLen - offload::ETHERNET_HEADER > m_maxUnitSize)
+    {
+      frames = offload::SegmentTcp (frame, frameLen, m_maxUnitSize);
+      if (frames.empty ())
+        {
+          ++m_framesDropped;
+        }
+    }
+  else
+    {
+      if (header.flags & offload::VIRTIO_NET_HDR_F_NEEDS_CSUM)
+        {
+          offload::CompleteChecksum (frame, frameLen, header.csumStart, header.csumOffset);
+        }
+      frames.emplace_back (frame, frame + frameLen);
+    }
+  std::free (buf);
+
+  for (const auto &bytes : frames)
+    {
+      Ptr<Packet> packet = Create<Packet> (bytes.data (), bytes.size ());
+      EthernetHeader ethernet (false);
+      packet->RemoveHeader (ethernet);
+      // 802.3 length frames (STP and the like) have no place in the model
+      if (ethernet.GetLengthType () < 0x0600)
+        {
+          continue;
+        }
+      ++m_packetsSent;
+      m_bridgedDevice->SendFrom (packet, ethernet.GetSource (), ethernet.GetDestination (),
+                                 ethernet.GetLengthType ());
+    }
+}
+
+inline bool
+OffloadTapBridge::DiscardFromBridgedDevice (Ptr<NetDevice> device, Ptr<const Packet> packet,
+                                            uint16_t protocol, const Address &src)
+{
+  return true;
+}
+
+inline void
+OffloadTapBridge::ReceiveFromBridgedDevice (Ptr<NetDevice> device, Ptr<const Packet> packet,
+                                            uint16_t protocol, const Address &src,
+                                            const Address &dst,
+                                            NetDevice::PacketType packetType)
+{
+  if (m_fd < 0)
+    {
+      return;
+    }
+  Ptr<Packet> p = packet->Copy ();
+  EthernetHeader ethernet (false);
+  ethernet.SetSource (Mac48Address::ConvertFrom (src));
+  ethernet.SetDestination (Mac48Address::ConvertFrom (dst));
+  ethernet.SetLengthType (protocol);
+  p->AddHeader (ethernet);
+
+  std::vector<uint8_t> buf (sizeof (offload::VirtioNetHeader) + p->GetSize ());
+  uint8_t *frame = buf.data () + sizeof (offload::VirtioNetHeader);
+  p->CopyData (frame, p->GetSize ());
+  offload::VirtioNetHeader header = offload::EgressHeader (frame, p->GetSize (), m_egressMtu);
+  std::memcpy (buf.data (), &header, sizeof (header));
+  ssize_t written = write (m_fd, buf.data (), buf.size ());
+  NS_ABORT_MSG_IF (written != ssize_t (buf.size ()),
+                   "OffloadTapBridge: write to " << m_deviceName << ": " << std::strerror (errno));
+}
+
+inline void
+OffloadTapBridge::SetIfIndex (const uint32_t index)
+{
+  m_ifIndex = index;
+}
+
+inline uint32_t
+OffloadTapBridge::GetIfIndex () const
+{
+  return m_ifIndex;
+}
+
+inline Ptr<Channel>
+OffloadTapBridge::GetChannel () const
+{
+  return nullptr;
+}
+
+inline void
+OffloadTapBridge::SetAddress (Address address)
+{
+}
+
+inline Address
+OffloadTapBridge::GetAddress () const
+{
+  return m_bridgedDevice ? m_bridgedDevice->GetAddress () : Address ();
+}
+
+inline bool
+OffloadTapBridge::SetMtu (const uint16_t mtu)
+{
+  m_mtu = mtu;
+  return true;
+}
+
+inline uint16_t
+OffloadTapBridge::GetMtu () const
+{
+  return m_mtu;
+}
+
+inline bool
+OffloadTapBridge::IsLinkUp () const
+{
+  return true;
+}
+
+inline void
+OffloadTapBridge::AddLinkChangeCallback (Callback<void> callback)
+{
+}
+
+inline bool
+OffloadTapBridge::IsBroadcast () const
+{
+  return true;
+}
+
+inline Address
+OffloadTapBridge::GetBroadcast () const
+{
+  return Mac48Address ("ff:ff:ff:ff:ff:ff");
+}
+
+inline bool
+OffloadTapBridge::IsMulticast () const
+{
+  return true;
+}
+
+inline Address
+OffloadTapBridge::GetMulticast (Ipv4Address multicastGroup) const
+{
+  return Mac48Address::GetMulticast (multicastGroup);
+}
+
+inline Address
+OffloadTapBridge::GetMulticast (Ipv6Address addr) const
+{
+  return Mac48Address::GetMulticast (addr);
+}
+
+inline bool
+OffloadTapBridge::IsPointToPoint () const
+{
+  return false;
+}
+
+inline bool
+OffloadTapBridge::IsBridge () const
+{
+  return true;
+}
+
+inline bool
+OffloadTapBridge::Send (Ptr<Packet> packet, const Address &dest, uint16_t protocolNumber)
+{
+  return false;
+}
+
+inline bool
+OffloadTapBridge::SendFrom (Ptr<Packet> packet, const Address &source, const Address &dest,
+                            uint16_t protocolNumber)
+{
+  return false;
+}
+
+inline Ptr<Node>
+OffloadTapBridge::GetNode () const
+{
+  return m_node;
+}
+
+inline void
+OffloadTapBridge::SetNode (Ptr<Node> node)
+{
+  m_node = node;
+}
+
+inline bool
+OffloadTapBridge::NeedsArp () const
+{
+  return true;
+}
+
+inline void
+OffloadTapBridge::SetReceiveCallback (NetDevice::ReceiveCallback cb)
+{
+}
+
+inline void
+OffloadTapBridge::SetPromiscReceiveCallback (NetDevice::PromiscReceiveCallback cb)
+{
+}
+
+inline bool
+OffloadTapBridge::SupportsSendFrom () const
+{
+  return false;
+}
+
+} // namespace ns3
+
+#endif /* OFFLOAD_TAP_BRIDGE_H */
+/*
+ * ns3 network simulator code
+ * Copyright 2023 Carnegie Mellon University.
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * Released under a MIT (SEI)-style license, please see license.txt or contact permission@sei.cmu.edu for full terms.
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release and unlimited distribution.  Please see Copyright notice for non-US Government use and distribution.
+ * This Software includes and/or makes use of the following Third-Party Software subject to its own license:
+ * 1. ns-3 (https://www.nsnam.org/about/) Copyright 2011 nsnam.
+ * DM23-0109
+ */
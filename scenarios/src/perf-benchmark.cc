@@ -0,0 +1,771 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/csma-module.h"
+#include "ns3/point-to-point-helper.h"
+
+// nr stuff
+#include "ns3/mobility-module.h"
+#include "ns3/nr-module.h"
+#include "ns3/antenna-module.h"
+#include "ns3/three-gpp-channel-model.h"
+
+#include "nr-cell-limits.h"
+#include "slot-bucket-scheduler.h"
+
+//
+// Non-realtime benchmark scenarios.  Each run builds one topology, runs it as
+// fast as the default simulator allows and prints a single JSON line with the
+// setup time, events/sec, simulated seconds per wall-clock second and peak RSS.
+// scripts/benchmark.sh runs the whole matrix and compares it to the baseline.
+//
+//   p2p-echo  the point-to-point UDP echo of first.cc
+//   csma      the CSMA LAN of tap-csma-scenario.cc with echo traffic in place
+//             of the tap devices
+//   nr        the NR/EPC topology of cttc-3gpp-channel-scratch.cc with
+//             downlink UDP traffic from the remote host to every UE
+//
+// With --replications=N the topology is built once and N forked workers run
+// it with consecutive RngRun values, so the setup cost of a Monte Carlo batch
+// is paid once instead of once per seed.
+//
+// --scheduler picks the event queue: map (the ns-3 default), heap, list,
+// calendar or slot-bucket (slot-bucket-scheduler.h, one bucket per timestamp
+// for the per-UE events the NR scenario schedules at every slot boundary).
+// --coalesce sends the NR traffic of all UEs from one slot-tick event
+// (SlotTickClient) instead of one UdpClient send event per UE.
+//
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("PerfBenchmark");
+
+// AssignStreams calls for the random variables of the scenario.  A forked
+// replication replays them after switching RngRun, which recreates those
+// streams for its own run; variables no helper reaches keep the run of the
+// parent.
+static std::vector<std::function<int64_t (int64_t)>> g_streamAssigners;
+
+// IPv4 packets delivered to a local protocol on any node, the outcome every
+// replication reports
+static uint64_t g_delivered = 0;
+
+// What a replication sends back to the parent, small enough for a single
+// atomic write to the shared pipe
+struct ReplicationResult
+{
+  uint32_t replication;
+  uint64_t run;
+  double runTime;
+  uint64_t events;
+  uint64_t delivered;
+};
+
+int64_t
+AssignAllStreams ()
+{
+  int64_t stream = 1;
+  for (const auto &assign : g_streamAssigners)
+    {
+      stream += assign (stream);
+    }
+  return stream - 1;
+}
+
+void
+CountDelivered (const Ipv4Header &header, Ptr<const Packet> packet, uint32_t interface)
+{
+  ++g_delivered;
+}
+
+// Downlink traffic to every UE from a single slot-tick event.  It sends what
+// one UdpClient per UE would, from the same sockets and ports and in the same
+// order, but walks a contiguous array of per-UE state once per interval
+// instead of running one send event per UE at the same timestamp.
+class SlotTickClient : public Application
+{
+public:
+  static TypeId GetTypeId ();
+
+  SlotTickClient ();
+
+  void SetTraffic (Time interval, uint32_t packetSize);
+  void AddUe (Ipv4Address address, uint16_t port);
+
+private:
+  struct UeState
+  {
+    Ipv4Address address;
+    uint16_t port;
+    Ptr<Socket> socket;
+    uint32_t sent;
+  };
+
+  void StartApplication () override;
+  void StopApplication () override;
+  void Tick ();
+
+  Time m_interval;
+  uint32_t m_packetSize;
+  std::vector<UeState> m_ues;
+  EventId m_tickEvent;
+};
+
+NS_OBJECT_ENSURE_REGISTERED (SlotTickClient);
+
+TypeId
+SlotTickClient::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::SlotTickClient")
+                          .SetParent<Application> ()
+                          .AddConstructor<SlotTickClient> ();
+  return tid;
+}
+
+SlotTickClient::SlotTickClient () : m_interval (MilliSeconds (1)), m_packetSize (1024)
+{
+}
+
+void
+SlotTickClient::SetTraffic (Time interval, uint32_t packetSize)
+{
+  m_interval = interval;
+  m_packetSize = packetSize;
+}
+
+void
+SlotTickClient::AddUe (Ipv4Address address, uint16_t port)
+{
+  m_ues.push_back ({address, port, nullptr, 0});
+}
+
+void
+SlotTickClient::StartApplication ()
+{
+  // sockets in UE order, so they get the source ports the UdpClients would
+  for (auto &ue : m_ues)
+    {
+      ue.socket = Socket::CreateSocket (GetNode (), UdpSocketFactory::GetTypeId ());
+      NS_ABORT_MSG_IF (ue.socket->Bind () == -1, "Failed to bind socket");
+      ue.socket->Connect (InetSocketAddress (ue.address, ue.port));
+      ue.socket->SetRecvCallback (MakeNullCallback<void, Ptr<Socket>> ());
+      ue.socket->SetAllowBroadcast (true);
+    }
+  m_tickEvent = Simulator::ScheduleNow (&SlotTickClient::Tick, this);
+}
+
+void
+SlotTickClient::StopApplication ()
+{
+  Simulator::Cancel (m_tickEvent);
+}
+
+void
+SlotTickClient::Tick ()
+{
+  for (auto &ue : m_ues)
+    {
+      // the payload and sequence header of UdpClient::Send
+      SeqTsHeader seqTs;
+      seqTs.SetSeq (ue.sent);
+      Ptr<Packet> packet = Create<Packet> (m_packetSize - (8 + 4));
+      packet->AddHeader (seqTs);
+      if (ue.socket->Send (packet) >= 0)
+        {
+          ++ue.sent;
+        }
+    }
+  m_tickEvent = Simulator::Schedule (m_interval, &SlotTickClient::Tick, this);
+}
+
+void
+BuildP2pEcho (Time interval, uint32_t packetSize, double simTime)
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  PointToPointHelper pointToPoint;
+  pointToPoint.SetDeviceAttribute ("DataRate", StringValue ("5Mbps"));
+  pointToPoint.SetChannelAttribute ("Delay", StringValue ("2ms"));
+  NetDeviceContainer devices = pointToPoint.Install (nodes);
+
+  InternetStackHelper stack;
+  stack.Install (nodes);
+
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+
+  UdpEchoServerHelper echoServer (9);
+  ApplicationContainer serverApps = echoServer.Install (nodes.Get (1));
+  serverApps.Start (Seconds (0.0));
+  serverApps.Stop (Seconds (simTime));
+
+  UdpEchoClientHelper echoClient (interfaces.GetAddress (1), 9);
+  echoClient.SetAttribute ("MaxPackets", UintegerValue (0xFFFFFFFF));
+  echoClient.SetAttribute ("Interval", TimeValue (interval));
+  echoClient.SetAttribute ("PacketSize", UintegerValue (packetSize));
+  ApplicationContainer clientApps = echoClient.Install (nodes.Get (0));
+  clientApps.Start (Seconds (0.1));
+  clientApps.Stop (Seconds (simTime));
+}
+
+void
+BuildCsma (uint32_t numNodes, Time interval, uint32_t packetSize, double simTime)
+{
+  NodeContainer nodes;
+  nodes.Create (numNodes);
+
+  CsmaHelper csma;
+  csma.SetChannelAttribute ("DataRate", DataRateValue (5000000));
+  NetDeviceContainer devices = csma.Install (nodes);
+
+  InternetStackHelper stack;
+  stack.Install (nodes);
+
+  Ipv4AddressHelper address;
+  address.SetBase ("10.0.0.0", "255.255.0.0");
+  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+  g_streamAssigners.push_back (
+      [devices] (int64_t stream) { return CsmaHelper ().AssignStreams (devices, stream); });
+
+  // every node echoes against the first one, as the tap hosts would
+  UdpEchoServerHelper echoServer (9);
+  ApplicationContainer serverApps = echoServer.Install (nodes.Get (0));
+  serverApps.Start (Seconds (0.0));
+  serverApps.Stop (Seconds (simTime));
+
+  UdpEchoClientHelper echoClient (interfaces.GetAddress (0), 9);
+  echoClient.SetAttribute ("MaxPackets", UintegerValue (0xFFFFFFFF));
+  echoClient.SetAttribute ("Interval", TimeValue (interval));
+  echoClient.SetAttribute ("PacketSize", UintegerValue (packetSize));
+  for (uint32_t i = 1; i < numNodes; ++i)
+    {
+      ApplicationContainer clientApps = echoClient.Install (nodes.Get (i));
+      clientApps.Start (Seconds (0.1));
+      clientApps.Stop (Seconds (simTime));
+    }
+}
+
+void
+BuildNr (uint32_t numUes, uint32_t numGnbs, Time interval, uint32_t packetSize, double simTime,
+         bool coalesce)
+{
+  double frequency = 28e9;
+  double bandwidth = 100e6;
+  double txPower = 40;
+  double hBS = 35;
+  double hUT = 1.5;
+  double interSiteDistance = 200;
+  uint32_t uesPerGnb = (numUes + numGnbs - 1) / numGnbs;
+  NS_ABORT_MSG_IF (uesPerGnb >= MAX_UES_PER_CELL,
+                   "At most " << MAX_UES_PER_CELL - 1 << " UEs per gNB, increase --numGnbs");
+
+  Config::SetDefault ("ns3::LteRlcUm::MaxTxBufferSize", UintegerValue (999999999));
+  Config::SetDefault ("ns3::LteEnbRrc::SrsPeriodicity",
+                      UintegerValue (SrsPeriodicityFor (uesPerGnb)));
+
+  NodeContainer enbNodes;
+  enbNodes.Create (numGnbs);
+  NodeContainer ueNodes;
+  ueNodes.Create (numUes);
+
+  // gNBs on a line, UEs on a ring around the gNB they belong to
+  Ptr<ListPositionAllocator> enbPositionAlloc = CreateObject<ListPositionAllocator> ();
+  for (uint32_t g = 0; g < numGnbs; ++g)
+    {
+      enbPositionAlloc->Add (Vector (g * interSiteDistance, 0.0, hBS));
+    }
+  MobilityHelper enbmobility;
+  enbmobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  enbmobility.SetPositionAllocator (enbPositionAlloc);
+  enbmobility.Install (enbNodes);
+
+  Ptr<ListPositionAllocator> uePositionAlloc = CreateObject<ListPositionAllocator> ();
+  for (uint32_t u = 0; u < numUes; ++u)
+    {
+      double angle = 2 * M_PI * (u / numGnbs) / uesPerGnb;
+      double radius = 20 + 60 * ((u / numGnbs) % 2);
+      uePositionAlloc->Add (Vector ((u % numGnbs) * interSiteDistance + radius * std::cos (angle),
+                                    radius * std::sin (angle), hUT));
+    }
+  MobilityHelper uemobility;
+  uemobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  uemobility.SetPositionAllocator (uePositionAlloc);
+  uemobility.Install (ueNodes);
+
+  Ptr<NrPointToPointEpcHelper> epcHelper = CreateObject<NrPointToPointEpcHelper> ();
+  Ptr<IdealBeamformingHelper> beamHelper = CreateObject<IdealBeamformingHelper> ();
+  Ptr<NrHelper> nrHelper = CreateObject<NrHelper> ();
+  nrHelper->SetBeamformingHelper (beamHelper);
+  nrHelper->SetEpcHelper (epcHelper);
+
+  CcBwpCreator ccBwpCreator;
+  CcBwpCreator::SimpleOperationBandConf bandConf (frequency, bandwidth, 1,
+                                                  BandwidthPartInfo::RMa);
+  OperationBandInfo band = ccBwpCreator.CreateOperationBandContiguousCc (bandConf);
+  nrHelper->InitializeOperationBand (&band);
+  BandwidthPartInfoPtrVector allBwps = CcBwpCreator::GetAllBwps ({band});
+
+  beamHelper->SetAttribute ("BeamformingMethod", TypeIdValue (DirectPathBeamforming::GetTypeId ()));
+  nrHelper->SetSchedulerTypeId (NrMacSchedulerTdmaRR::GetTypeId ());
+
+  nrHelper->SetUeAntennaAttribute ("NumRows", UintegerValue (2));
+  nrHelper->SetUeAntennaAttribute ("NumColumns", UintegerValue (4));
+  nrHelper->SetUeAntennaAttribute ("AntennaElement",
+                                   PointerValue (CreateObject<IsotropicAntennaModel> ()));
+  nrHelper->SetGnbAntennaAttribute ("NumRows", UintegerValue (8));
+  nrHelper->SetGnbAntennaAttribute ("NumColumns", UintegerValue (8));
+  nrHelper->SetGnbAntennaAttribute ("AntennaElement",
+                                    PointerValue (CreateObject<IsotropicAntennaModel> ()));
+
+  NetDeviceContainer enbNetDev = nrHelper->InstallGnbDevice (enbNodes, allBwps);
+  NetDeviceContainer ueNetDev = nrHelper->InstallUeDevice (ueNodes, allBwps);
+  for (uint32_t g = 0; g < numGnbs; ++g)
+    {
+      nrHelper->GetGnbPhy (enbNetDev.Get (g), 0)->SetTxPower (txPower);
+    }
+  for (auto it = enbNetDev.Begin (); it != enbNetDev.End (); ++it)
+    {
+      DynamicCast<NrGnbNetDevice> (*it)->UpdateConfig ();
+    }
+  for (auto it = ueNetDev.Begin (); it != ueNetDev.End (); ++it)
+    {
+      DynamicCast<NrUeNetDevice> (*it)->UpdateConfig ();
+    }
+
+  Ptr<Node> pgw = epcHelper->GetPgwNode ();
+  NodeContainer remoteHostContainer;
+  remoteHostContainer.Create (1);
+  Ptr<Node> remoteHost = remoteHostContainer.Get (0);
+  InternetStackHelper internetStackHelper;
+  internetStackHelper.Install (remoteHostContainer);
+
+  PointToPointHelper p2ph;
+  p2ph.SetDeviceAttribute ("DataRate", DataRateValue (DataRate ("100Gb/s")));
+  p2ph.SetDeviceAttribute ("Mtu", UintegerValue (2500));
+  p2ph.SetChannelAttribute ("Delay", TimeValue (Seconds (0.010)));
+  NetDeviceContainer p2pInetDevs = p2ph.Install (pgw, remoteHost);
+
+  Ipv4AddressHelper ipv4h;
+  ipv4h.SetBase ("1.0.0.0", "/8");
+  ipv4h.Assign (p2pInetDevs);
+  Ipv4StaticRoutingHelper ipv4RoutingHelper;
+  Ptr<Ipv4StaticRouting> staticRoutingRemoteHost =
+      ipv4RoutingHelper.GetStaticRouting (remoteHost->GetObject<Ipv4> ());
+  staticRoutingRemoteHost->AddNetworkRouteTo (Ipv4Address ("7.0.0.0"), Ipv4Mask ("/8"), 1);
+
+  internetStackHelper.Install (ueNodes);
+  Ipv4InterfaceContainer ueIpIface = epcHelper->AssignUeIpv4Address (ueNetDev);
+  for (uint32_t u = 0; u < ueNodes.GetN (); ++u)
+    {
+      Ptr<Ipv4StaticRouting> ueStaticRouting =
+          ipv4RoutingHelper.GetStaticRouting (ueNodes.Get (u)->GetObject<Ipv4> ());
+      ueStaticRouting->SetDefaultRoute (epcHelper->GetUeDefaultGatewayAddress (), 1);
+    }
+  nrHelper->AttachToClosestEnb (ueNetDev, enbNetDev);
+
+  // the band goes out of scope, keep its channel models for the replications
+  std::vector<Ptr<ThreeGppPropagationLossModel>> propagation;
+  std::vector<Ptr<ThreeGppSpectrumPropagationLossModel>> fading;
+  for (const auto &bwp : allBwps)
+    {
+      propagation.push_back (DynamicCast<ThreeGppPropagationLossModel> (bwp.get ()->m_propagation));
+      fading.push_back (bwp.get ()->m_3gppChannel);
+    }
+  g_streamAssigners.push_back ([=] (int64_t stream) {
+    int64_t first = stream;
+    stream += nrHelper->AssignStreams (enbNetDev, stream);
+    stream += nrHelper->AssignStreams (ueNetDev, stream);
+    for (const auto &loss : propagation)
+      {
+        if (loss)
+          {
+            stream += loss->AssignStreams (stream);
+          }
+        if (loss && loss->GetChannelConditionModel ())
+          {
+            stream += loss->GetChannelConditionModel ()->AssignStreams (stream);
+          }
+      }
+    for (const auto &model : fading)
+      {
+        Ptr<ThreeGppChannelModel> channel =
+            model ? DynamicCast<ThreeGppChannelModel> (model->GetChannelModel ()) : nullptr;
+        if (channel)
+          {
+            stream += channel->AssignStreams (stream);
+          }
+      }
+    return stream - first;
+  });
+
+  uint16_t port = 1234;
+  UdpServerHelper server (port);
+  ApplicationContainer serverApps = server.Install (ueNodes);
+  serverApps.Start (Seconds (0.0));
+  serverApps.Stop (Seconds (simTime));
+  if (coalesce)
+    {
+      Ptr<SlotTickClient> client = CreateObject<SlotTickClient> ();
+      client->SetTraffic (interval, packetSize);
+      for (uint32_t u = 0; u < ueNodes.GetN (); ++u)
+        {
+          client->AddUe (ueIpIface.GetAddress (u), port);
+        }
+      remoteHost->AddApplication (client);
+      client->SetStartTime (Seconds (0.4));
+      client->SetStopTime (Seconds (simTime));
+      return;
+    }
+  for (uint32_t u = 0; u < ueNodes.GetN (); ++u)
+    {
+      UdpClientHelper client (ueIpIface.GetAddress (u), port);
+      client.SetAttribute ("MaxPackets", UintegerValue (0xFFFFFFFF));
+      client.SetAttribute ("Interval", TimeValue (interval));
+      client.SetAttribute ("PacketSize", UintegerValue (packetSize));
+      ApplicationContainer clientApps = client.Install (remoteHost);
+      clientApps.Start (Seconds (0.4));
+      clientApps.Stop (Seconds (simTime));
+    }
+}
+
+[[noreturn]] void
+RunReplication (uint32_t replication, uint64_t run, int fd)
+{
+  RngSeedManager::SetRun (run);
+  AssignAllStreams ();
+
+  auto runStart = std::chrono::steady_clock::now ();
+  Simulator::Run ();
+  auto runEnd = std::chrono::steady_clock::now ();
+
+  ReplicationResult result;
+  result.replication = replication;
+  result.run = run;
+  result.runTime = std::chrono::duration<double> (runEnd - runStart).count ();
+  result.events = Simulator::GetEventCount ();
+  result.delivered = g_delivered;
+  ssize_t written = write (fd, &result, sizeof (result));
+  // skip the destructors, the parent still owns everything that was built
+  _exit (written == sizeof (result) ? 0 : 1);
+}
+
+void
+DrainResults (int fd, std::string &buffer, std::vector<ReplicationResult> &results)
+{
+  char chunk[4096];
+  ssize_t n;
+  while ((n = read (fd, chunk, sizeof (chunk))) > 0)
+    {
+      buffer.append (chunk, n);
+    }
+  while (buffer.size () >= sizeof (ReplicationResult))
+    {
+      ReplicationResult result;
+      std::memcpy (&result, buffer.data (), sizeof (result));
+      results.push_back (result);
+      buffer.erase (0, sizeof (result));
+    }
+}
+
+// Launches every replication as a process of its own that builds the topology
+// again, as a Monte Carlo batch does without fork-after-setup, with the same
+// arguments and at most workers at a time.  Returns the wall time of the batch.
+double
+TimeIndependentLaunches (int argc, char *argv[], uint32_t replications, uint32_t workers,
+                         uint64_t baseRun, uint32_t &failed)
+{
+  std::vector<std::string> args;
+  for (int i = 1; i < argc; ++i)
+    {
+      std::string arg = argv[i];
+      if (arg.rfind ("--replications", 0) != 0 && arg.rfind ("--timeIndependent", 0) != 0 &&
+          arg.rfind ("--RngRun", 0) != 0)
+        {
+          args.push_back (arg);
+        }
+    }
+  std::cout.flush ();
+
+  auto start = std::chrono::steady_clock::now ();
+  uint32_t started = 0;
+  uint32_t running = 0;
+  while (started < replications || running > 0)
+    {
+      while (started < replications && running < workers)
+        {
+          pid_t pid = fork ();
+          NS_ABORT_MSG_IF (pid < 0, "fork: " << std::strerror (errno));
+          if (pid == 0)
+            {
+              args.push_back ("--RngRun=" + std::to_string (baseRun + started));
+              std::vector<char *> childArgv = {argv[0]};
+              for (auto &arg : args)
+                {
+                  childArgv.push_back (&arg[0]);
+                }
+              childArgv.push_back (nullptr);
+              // only the timing matters, not the JSON line of each launch
+              int devNull = open ("/dev/null", O_WRONLY);
+              dup2 (devNull, STDOUT_FILENO);
+              execv ("/proc/self/exe", childArgv.data ());
+              _exit (127);
+            }
+          ++started;
+          ++running;
+        }
+      int status;
+      if (waitpid (-1, &status, 0) > 0)
+        {
+          --running;
+          if (!WIFEXITED (status) || WEXITSTATUS (status) != 0)
+            {
+              ++failed;
+            }
+        }
+    }
+  return std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+}
+
+// Runs the already built topology once per replication, each in a forked
+// worker with its own RngRun, and reports every run plus the wall time of the
+// batch.  With timeIndependent it also times the same batch as independent
+// launches, which gives the measured speedup.
+int
+RunReplications (const std::string &scenario, uint32_t replications, uint32_t workers,
+                 double setupTime, int64_t streams, bool timeIndependent, int argc, char *argv[])
+{
+  Config::ConnectWithoutContext ("/NodeList/*/$ns3::Ipv4L3Protocol/LocalDeliver",
+                                 MakeCallback (&CountDelivered));
+  uint64_t baseRun = RngSeedManager::GetRun ();
+
+  int fds[2];
+  NS_ABORT_MSG_IF (pipe (fds) != 0, "pipe: " << std::strerror (errno));
+  // read while workers still run, so a full pipe never blocks them
+  fcntl (fds[0], F_SETFL, O_NONBLOCK);
+  std::cout.flush ();
+
+  auto wallStart = std::chrono::steady_clock::now ();
+  std::vector<ReplicationResult> results;
+  std::string buffer;
+  uint32_t started = 0;
+  uint32_t running = 0;
+  uint32_t failed = 0;
+  while (started < replications || running > 0)
+    {
+      while (started < replications && running < workers)
+        {
+          pid_t pid = fork ();
+          NS_ABORT_MSG_IF (pid < 0, "fork: " << std::strerror (errno));
+          if (pid == 0)
+            {
+              close (fds[0]);
+              RunReplication (started, baseRun + started, fds[1]);
+            }
+          ++started;
+          ++running;
+        }
+      struct pollfd pfd = {fds[0], POLLIN, 0};
+      poll (&pfd, 1, 50);
+      DrainResults (fds[0], buffer, results);
+      int status;
+      pid_t pid;
+      while ((pid = waitpid (-1, &status, WNOHANG)) > 0)
+        {
+          --running;
+          if (!WIFEXITED (status) || WEXITSTATUS (status) != 0)
+            {
+              ++failed;
+            }
+        }
+    }
+  auto wallEnd = std::chrono::steady_clock::now ();
+  close (fds[1]);
+  DrainResults (fds[0], buffer, results);
+  close (fds[0]);
+
+  std::sort (results.begin (), results.end (),
+             [] (const ReplicationResult &a, const ReplicationResult &b) {
+               return a.replication < b.replication;
+             });
+  double runTimeSum = 0;
+  double deliveredSum = 0;
+  double deliveredSquares = 0;
+  for (const auto &result : results)
+    {
+      std::cout << "{\"replication\": " << result.replication << ", \"run\": " << result.run
+                << ", \"runTime\": " << result.runTime << ", \"events\": " << result.events
+                << ", \"delivered\": " << result.delivered << "}" << std::endl;
+      runTimeSum += result.runTime;
+      deliveredSum += result.delivered;
+      deliveredSquares += static_cast<double> (result.delivered) * result.delivered;
+    }
+  NS_ABORT_MSG_IF (results.empty (), "All " << replications << " replications failed");
+
+  // modelled from the measured setup and run times: independent launches pay
+  // the setup once per replication, forked ones once per batch
+  double n = results.size ();
+  double meanRunTime = runTimeSum / n;
+  double meanDelivered = deliveredSum / n;
+  double deliveredStddev =
+      n > 1 ? std::sqrt (std::max (0.0, (deliveredSquares - n * meanDelivered * meanDelivered) /
+                                            (n - 1)))
+            : 0;
+  double estimatedIndependentTime = n * (setupTime + meanRunTime);
+  double estimatedReplicatedTime = setupTime + runTimeSum;
+  double replicatedWallTime =
+      setupTime + std::chrono::duration<double> (wallEnd - wallStart).count ();
+  std::cout << "{\"scenario\": \"" << scenario << "\", \"replications\": " << results.size ()
+            << ", \"failed\": " << failed << ", \"workers\": " << workers
+            << ", \"setupTime\": " << setupTime << ", \"meanRunTime\": " << meanRunTime
+            << ", \"meanDelivered\": " << meanDelivered
+            << ", \"deliveredStddev\": " << deliveredStddev
+            << ", \"estimatedIndependentTime\": " << estimatedIndependentTime
+            << ", \"estimatedReplicatedTime\": " << estimatedReplicatedTime
+            << ", \"estimatedSpeedup\": " << estimatedIndependentTime / estimatedReplicatedTime
+            << ", \"replicatedWallTime\": " << replicatedWallTime
+            // only the streams the AssignStreams calls reach follow RngRun; any
+            // other variable keeps the parent's run, so the replications are
+            // not fully independent
+            << ", \"reseededStreams\": " << streams << ", \"otherStreamsShareRun\": true";
+  if (timeIndependent)
+    {
+      uint32_t independentFailed = 0;
+      double independentWallTime = TimeIndependentLaunches (argc, argv, replications, workers,
+                                                            baseRun, independentFailed);
+      std::cout << ", \"independentWallTime\": " << independentWallTime
+                << ", \"independentFailed\": " << independentFailed
+                << ", \"speedup\": " << independentWallTime / replicatedWallTime;
+      failed += independentFailed;
+    }
+  std::cout << "}" << std::endl;
+
+  Simulator::Destroy ();
+  return failed == 0 ? 0 : 1;
+}
+
+int
+main (int argc, char *argv[])
+{
+  auto setupStart = std::chrono::steady_clock::now ();
+
+  std::string scenario = "p2p-echo";
+  uint32_t numNodes = 6;
+  uint32_t numUes = 2;
+  uint32_t numGnbs = 1;
+  double simTime = 10;
+  Time interval = MilliSeconds (1);
+  uint32_t packetSize = 1024;
+  std::string scheduler = "map";
+  uint32_t replications = 0;
+  uint32_t workers = sysconf (_SC_NPROCESSORS_ONLN);
+  bool timeIndependent = false;
+  bool coalesce = false;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("scenario", "Benchmark scenario: p2p-echo, csma or nr", scenario);
+  cmd.AddValue ("numNodes", "Number of CSMA nodes (csma)", numNodes);
+  cmd.AddValue ("numUes", "Number of UEs (nr)", numUes);
+  cmd.AddValue ("numGnbs", "Number of gNBs, UEs are spread evenly over them (nr)", numGnbs);
+  cmd.AddValue ("simTime", "Simulated seconds", simTime);
+  cmd.AddValue ("interval", "Interval between packets of each traffic source", interval);
+  cmd.AddValue ("packetSize", "Application payload size in bytes", packetSize);
+  cmd.AddValue ("scheduler", "Event queue: map, heap, list, calendar or slot-bucket", scheduler);
+  cmd.AddValue ("coalesce",
+                "Send the traffic of all UEs from one slot-tick event instead of one "
+                "UdpClient event per UE, with identical packets (nr)",
+                coalesce);
+  cmd.AddValue ("replications",
+                "Build once and run this many forked replications with RngRun, RngRun+1, ...",
+                replications);
+  cmd.AddValue ("workers", "Replications running at the same time", workers);
+  cmd.AddValue ("timeIndependent",
+                "Also run the replications as independent launches and report the measured "
+                "speedup",
+                timeIndependent);
+  cmd.Parse (argc, argv);
+
+  std::string schedulerType = SchedulerTypeName (scheduler);
+  NS_ABORT_MSG_IF (schedulerType.empty (), "Unknown scheduler " << scheduler);
+  GlobalValue::Bind ("SchedulerType", StringValue (schedulerType));
+
+  if (scenario == "p2p-echo")
+    {
+      BuildP2pEcho (interval, packetSize, simTime);
+    }
+  else if (scenario == "csma")
+    {
+      BuildCsma (numNodes, interval, packetSize, simTime);
+    }
+  else if (scenario == "nr")
+    {
+      BuildNr (numUes, numGnbs, interval, packetSize, simTime, coalesce);
+    }
+  else
+    {
+      NS_FATAL_ERROR ("Unknown scenario " << scenario);
+    }
+
+  g_streamAssigners.push_back ([] (int64_t stream) {
+    return InternetStackHelper ().AssignStreams (NodeContainer::GetGlobal (), stream);
+  });
+  int64_t streams = AssignAllStreams ();
+  Simulator::Stop (Seconds (simTime));
+
+  auto runStart = std::chrono::steady_clock::now ();
+  if (replications > 0)
+    {
+      NS_ABORT_MSG_IF (workers == 0, "--workers must be at least 1");
+      double setupTime = std::chrono::duration<double> (runStart - setupStart).count ();
+      return RunReplications (scenario, replications, workers, setupTime, streams,
+                              timeIndependent, argc, argv);
+    }
+  Simulator::Run ();
+  auto runEnd = std::chrono::steady_clock::now ();
+
+  double setupTime = std::chrono::duration<double> (runStart - setupStart).count ();
+  double runTime = std::chrono::duration<double> (runEnd - runStart).count ();
+  uint64_t events = Simulator::GetEventCount ();
+  double simSeconds = Simulator::Now ().GetSeconds ();
+  struct rusage usage;
+  getrusage (RUSAGE_SELF, &usage);
+
+  // keep the result on a single line so it can be picked out of the ns3 runner output
+  std::cout << "{\"scenario\": \"" << scenario << "\", \"numNodes\": " << numNodes
+            << ", \"numUes\": " << numUes << ", \"numGnbs\": " << numGnbs
+            << ", \"simTime\": " << simSeconds << ", \"setupTime\": " << setupTime
+            << ", \"scheduler\": \"" << scheduler << "\", \"runTime\": " << runTime
+            << ", \"events\": " << events << ", \"eventsPerSimSecond\": " << events / simSeconds
+            << ", \"eventsPerSecond\": " << events / runTime
+            << ", \"simSecondsPerWallSecond\": " << simSeconds / runTime
+            << ", \"peakRssKb\": " << usage.ru_maxrss << "}" << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
+/*
+ * ns3 network simulator code
+ * Copyright 2023 Carnegie Mellon University.
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * Released under a MIT (SEI)-style license, please see license.txt or contact permission@sei.cmu.edu for full terms.
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release and unlimited distribution.  Please see Copyright notice for non-US Government use and distribution.
+ * This Software includes and/or makes use of the following Third-Party Software subject to its own license:
+ * 1. ns-3 (https://www.nsnam.org/about/) Copyright 2011 nsnam.
+ * DM23-0109
+ */
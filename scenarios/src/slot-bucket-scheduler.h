@@ -0,0 +1,191 @@
+#ifndef SLOT_BUCKET_SCHEDULER_H
+#define SLOT_BUCKET_SCHEDULER_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "ns3/core-module.h"
+
+//
+// Event scheduler for scenarios where many events share a timestamp, such as
+// the per-UE PHY/MAC/RLC work an NR gNB schedules at every slot boundary.
+// Events are kept in one bucket per timestamp, a contiguous array in uid
+// order, so inserting into a slot that is already pending is an append and
+// removing the next event is an index increment.  Only the first event of a
+// slot pays for the ordered map lookup; the last bucket inserted into is
+// cached for the runs of same-slot inserts.
+//
+// Events run in the (timestamp, uid) order of every other ns-3 scheduler, so
+// results are identical.  Select it before anything touches the simulator:
+//
+//   GlobalValue::Bind ("SchedulerType", StringValue ("ns3::SlotBucketScheduler"));
+//
+
+namespace ns3 {
+
+class SlotBucketScheduler : public Scheduler
+{
+public:
+  static TypeId GetTypeId ();
+
+  SlotBucketScheduler ();
+  ~SlotBucketScheduler () override;
+
+  void Insert (const Event &ev) override;
+  bool IsEmpty () const override;
+  Event PeekNext () const override;
+  Event RemoveNext () override;
+  void Remove (const Event &ev) override;
+
+  // Timestamps with pending events
+  uint64_t GetBucketCount () const;
+
+private:
+  // Events of one timestamp, the ones before m_head already ran
+  struct Bucket
+  {
+    std::vector<Event> events;
+    std::size_t head = 0;
+  };
+  typedef std::map<uint64_t, Bucket> Buckets;
+
+  void EraseIfDone (Buckets::iterator it);
+
+  Buckets m_buckets;
+  Buckets::iterator m_last;
+};
+
+NS_OBJECT_ENSURE_REGISTERED (SlotBucketScheduler);
+
+inline TypeId
+SlotBucketScheduler::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::SlotBucketScheduler")
+                          .SetParent<Scheduler> ()
+                          .AddConstructor<SlotBucketScheduler> ();
+  return tid;
+}
+
+inline SlotBucketScheduler::SlotBucketScheduler () : m_last (m_buckets.end ())
+{
+}
+
+inline SlotBucketScheduler::~SlotBucketScheduler ()
+{
+}
+
+inline void
+SlotBucketScheduler::Insert (const Event &ev)
+{
+  if (m_last == m_buckets.end () || m_last->first != ev.key.m_ts)
+    {
+      m_last = m_buckets.emplace (ev.key.m_ts, Bucket ()).first;
+    }
+  std::vector<Event> &events = m_last->second.events;
+  if (events.size () == m_last->second.head || events.back ().key.m_uid < ev.key.m_uid)
+    {
+      events.push_back (ev);
+      return;
+    }
+  // uids are handed out in order, this only happens after they wrapped around
+  auto it = events.begin () + m_last->second.head;
+  while (it != events.end () && it->key < ev.key)
+    {
+      ++it;
+    }
+  events.insert (it, ev);
+}
+
+inline bool
+SlotBucketScheduler::IsEmpty () const
+{
+  return m_buckets.empty ();
+}
+
+inline Scheduler::Event
+SlotBucketScheduler::PeekNext () const
+{
+  NS_ASSERT (!IsEmpty ());
+  const Bucket &bucket = m_buckets.begin ()->second;
+  return bucket.events[bucket.head];
+}
+
+inline Scheduler::Event
+SlotBucketScheduler::RemoveNext ()
+{
+  NS_ASSERT (!IsEmpty ());
+  auto it = m_buckets.begin ();
+  Event ev = it->second.events[it->second.head++];
+  EraseIfDone (it);
+  return ev;
+}
+
+inline void
+SlotBucketScheduler::Remove (const Event &ev)
+{
+  auto it = m_buckets.find (ev.key.m_ts);
+  NS_ASSERT_MSG (it != m_buckets.end (), "Event not found");
+  std::vector<Event> &events = it->second.events;
+  for (auto i = events.begin () + it->second.head; i != events.end (); ++i)
+    {
+      if (i->key.m_uid == ev.key.m_uid)
+        {
+          NS_ASSERT (i->impl == ev.impl);
+          events.erase (i);
+          EraseIfDone (it);
+          return;
+        }
+    }
+  NS_ASSERT_MSG (false, "Event not found");
+}
+
+inline uint64_t
+SlotBucketScheduler::GetBucketCount () const
+{
+  return m_buckets.size ();
+}
+
+inline void
+SlotBucketScheduler::EraseIfDone (Buckets::iterator it)
+{
+  if (it->second.head < it->second.events.size ())
+    {
+      return;
+    }
+  if (it == m_last)
+    {
+      m_last = m_buckets.end ();
+    }
+  m_buckets.erase (it);
+}
+
+// TypeId name of an event queue by its short name: map (the ns-3 default),
+// heap, list, calendar or slot-bucket.  Empty for an unknown name.
+inline std::string
+SchedulerTypeName (const std::string &name)
+{
+  static const std::map<std::string, std::string> schedulers = {
+      {"map", "ns3::MapScheduler"},
+      {"heap", "ns3::HeapScheduler"},
+      {"list", "ns3::ListScheduler"},
+      {"calendar", "ns3::CalendarScheduler"},
+      {"slot-bucket", "ns3::SlotBucketScheduler"}};
+  auto it = schedulers.find (name);
+  return it == schedulers.end () ? std::string () : it->second;
+}
+
+} // namespace ns3
+
+#endif /* SLOT_BUCKET_SCHEDULER_H */
+/*
+ * ns3 network simulator code
+ * Copyright 2023 Carnegie Mellon University.
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * Released under a MIT (SEI)-style license, please see license.txt or contact permission@sei.cmu.edu for full terms.
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release and unlimited distribution.  Please see Copyright notice for non-US Government use and distribution.
+ * This Software includes and/or makes use of the following Third-Party Software subject to its own license:
+ * 1. ns-3 (https://www.nsnam.org/about/) Copyright 2011 nsnam.
+ * DM23-0109
+ */
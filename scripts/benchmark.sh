@@ -0,0 +1,67 @@
+#!/usr/bin/env bash
+
+# Runs the non-realtime benchmark matrix of scenarios/src/perf-benchmark.cc in the
+# ns-3 container and compares the results against benchmarks/baseline.json.
+#   THRESHOLD=0.10          relative change that counts as a regression
+#   UPDATE_BASELINE=1       store this run as the new baseline instead
+
+# Exit immediately if a commands exits with non-zero status
+set -e
+# A failed ns-3 run must not hide behind the grep of its output
+set -o pipefail
+
+threshold=${THRESHOLD:-0.10}
+
+# name and arguments of every benchmark case
+cases=(
+    "p2p-echo --scenario=p2p-echo --simTime=100 --interval=100us"
+    "csma --scenario=csma --numNodes=6 --simTime=100 --interval=1ms"
+    "nr-2ue --scenario=nr --numUes=2 --simTime=5"
+    "nr-50ue --scenario=nr --numUes=50 --simTime=2"
+    "nr-500ue --scenario=nr --numUes=500 --numGnbs=2 --simTime=1"
+    # per-UE events against one bucket per slot and against one slot-tick event
+    "nr-10ue --scenario=nr --numUes=10 --simTime=2"
+    "nr-10ue-slot --scenario=nr --numUes=10 --simTime=2 --scheduler=slot-bucket"
+    "nr-10ue-tick --scenario=nr --numUes=10 --simTime=2 --coalesce=true"
+    "nr-100ue --scenario=nr --numUes=100 --simTime=1"
+    "nr-100ue-slot --scenario=nr --numUes=100 --simTime=1 --scheduler=slot-bucket"
+    "nr-100ue-tick --scenario=nr --numUes=100 --simTime=1 --coalesce=true"
+    "nr-1000ue --scenario=nr --numUes=1000 --numGnbs=4 --simTime=0.5"
+    "nr-1000ue-slot --scenario=nr --numUes=1000 --numGnbs=4 --simTime=0.5 --scheduler=slot-bucket"
+    "nr-1000ue-tick --scenario=nr --numUes=1000 --numGnbs=4 --simTime=0.5 --coalesce=true"
+)
+
+date=$(date +"%d%m%Y")
+n=1
+while [[ -d "results/bench-${date}-${n}" ]] ; do
+    n=$(($n+1))
+done
+out="results/bench-${date}-${n}"
+mkdir -p "${out}"
+
+echo "Start ns-3 container..."
+docker compose -f scenarios/perf-benchmark.yaml up --detach
+cleanup() {
+    docker compose -f scenarios/perf-benchmark.yaml down
+}
+trap cleanup EXIT
+docker exec ns-3 ./ns3 build scratch/perf-benchmark > /dev/null
+echo "Done."
+
+for c in "${cases[@]}"; do
+    name=${c%% *}
+    args=${c#* }
+    echo "Running ${name}..."
+    docker exec ns-3 ./ns3 run --no-build "scratch/perf-benchmark ${args}" | grep '^{' > "${out}/${name}.json"
+    cat "${out}/${name}.json"
+done
+
+cleanup
+trap - EXIT
+
+compare_args=(--baseline benchmarks/baseline.json --dockerfile scenarios/images/ns-3.Dockerfile --threshold "${threshold}")
+if [[ "${UPDATE_BASELINE}" == "1" ]]; then
+    compare_args+=(--update)
+fi
+echo "Results available at ${out}"
+python3 scripts/benchmark_compare.py "${compare_args[@]}" "${out}"/*.json
@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+"""Compares benchmark results of scripts/benchmark.sh against a stored baseline.
+
+Each result file holds the JSON line printed by scenarios/src/perf-benchmark.cc;
+the case name is the file name without extension. The baseline also records the
+ns-3 and nr versions from the ns-3 Dockerfile, so a run after a version bump
+reports which versions are being compared. Exits with status 1 on regression.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+# metric -> True when higher is better
+METRICS = {
+    "eventsPerSecond": True,
+    "simSecondsPerWallSecond": True,
+    "setupTime": False,
+    "peakRssKb": False,
+}
+
+
+def read_versions(dockerfile):
+    versions = {}
+    with open(dockerfile) as f:
+        text = f.read()
+    match = re.search(r"ns-allinone-([0-9.]+?)\.tar", text)
+    if match:
+        versions["ns3"] = match.group(1)
+    match = re.search(r"nr\.git.*?git checkout (\S+)", text, re.S)
+    if match:
+        versions["nr"] = match.group(1)
+    return versions
+
+
+def read_results(paths):
+    results = {}
+    for path in paths:
+        with open(path) as f:
+            line = f.read().strip()
+        if not line:
+            print(f"warning: {path} is empty, skipping", file=sys.stderr)
+            continue
+        results[os.path.splitext(os.path.basename(path))[0]] = json.loads(line)
+    return results
+
+
+def compare(baseline, results, threshold):
+    regressions = 0
+    print(f"{'case':<16} {'metric':<24} {'baseline':>14} {'current':>14} {'change':>8}")
+    for name, current in sorted(results.items()):
+        base = baseline.get(name)
+        if base is None:
+            print(f"{name:<16} (no baseline)")
+            continue
+        for metric, higher_is_better in METRICS.items():
+            if metric not in base or metric not in current or base[metric] == 0:
+                continue
+            change = (current[metric] - base[metric]) / base[metric]
+            worse = -change if higher_is_better else change
+            flag = ""
+            if worse > threshold:
+                flag = "  REGRESSION"
+                regressions += 1
+            print(f"{name:<16} {metric:<24} {base[metric]:>14.4g} {current[metric]:>14.4g}"
+                  f" {change:>+8.1%}{flag}")
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--baseline", required=True)
+    parser.add_argument("--dockerfile", required=True)
+    parser.add_argument("--threshold", type=float, default=0.10)
+    parser.add_argument("--update", action="store_true", help="store the results as the new baseline")
+    parser.add_argument("results", nargs="+")
+    args = parser.parse_args()
+
+    versions = read_versions(args.dockerfile)
+    results = read_results(args.results)
+
+    if args.update or not os.path.exists(args.baseline):
+        os.makedirs(os.path.dirname(args.baseline) or ".", exist_ok=True)
+        with open(args.baseline, "w") as f:
+            json.dump({"versions": versions, "results": results}, f, indent=2, sort_keys=True)
+            f.write("\n")
+        print(f"Baseline stored in {args.baseline} for {versions}")
+        return 0
+
+    with open(args.baseline) as f:
+        baseline = json.load(f)
+    if baseline.get("versions") != versions:
+        print(f"ns-3/nr version changed: {baseline.get('versions')} -> {versions}")
+    regressions = compare(baseline.get("results", {}), results, args.threshold)
+    if regressions:
+        print(f"{regressions} metric(s) regressed by more than {args.threshold:.0%}")
+        return 1
+    print("No regressions.")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,147 @@
+#!/usr/bin/env bash
+
+# Runs the cttc-3gpp-channel-tap experiment without containers or sudo.
+# The script re-executes itself inside an unprivileged user, network and
+# mount namespace. There it owns the bridges, taps and veth pairs, the ghost
+# nodes are plain network namespaces and the Go server and curl run as local
+# processes inside them. Everything disappears with the namespaces on exit.
+#
+# Needs a local ns-3 build with the nr module (NS3_DIR) and user namespaces
+# enabled (kernel.unprivileged_userns_clone=1 on Debian/Ubuntu).
+#   NS3_DIR=~/ns-allinone-3.37/ns-3.37 scripts/local-emu_start.sh
+
+# Exit immediately if a commands exits with non-zero status
+set -e
+
+NS3_DIR=${NS3_DIR:-/usr/local/ns-allinone-3.37/ns-3.37}
+REPO_DIR=$(cd "$(dirname "$0")/.." && pwd)
+
+if [[ -z "${LOCAL_EMU_INNER}" ]]; then
+    if [[ ! -x "${NS3_DIR}/ns3" ]]; then
+        echo "ns-3 not found at ${NS3_DIR}, set NS3_DIR" >&2
+        exit 1
+    fi
+    work=$(mktemp -d /tmp/local-emu.XXXXXX)
+    # Build everything that needs the host network before leaving it
+    echo "Build scenario and server..."
+    ln -sf "${REPO_DIR}/scenarios/src/cttc-3gpp-channel-scratch.cc" "${NS3_DIR}/scratch/"
+    ln -sf "${REPO_DIR}/scenarios/src/emu-simulator-impl.h" "${NS3_DIR}/scratch/"
+    ln -sf "${REPO_DIR}/scenarios/src/nr-cell-limits.h" "${NS3_DIR}/scratch/"
+    ln -sf "${REPO_DIR}/scenarios/src/offload-tap-bridge.h" "${NS3_DIR}/scratch/"
+    ln -sf "${REPO_DIR}/scenarios/src/slot-bucket-scheduler.h" "${NS3_DIR}/scratch/"
+    (cd "${NS3_DIR}" && ./ns3 build > "${work}/build.log")
+    (cd "${REPO_DIR}/server" && go build -o "${work}/server" .)
+    echo "Done."
+    LOCAL_EMU_INNER=1 LOCAL_EMU_WORK="${work}" exec unshare --user --map-root-user --net --mount \
+        --propagation private "$0" "$@"
+fi
+
+work=${LOCAL_EMU_WORK}
+start=$(date +%s.%N)
+
+# TIME_DILATION=k runs the simulation k times slower than wall-clock time, the
+# server inherits the factor through the environment
+export TIME_DILATION=${TIME_DILATION:-1}
+if [[ "${TIME_DILATION}" != 1 ]]; then
+    NS3_ARGS="${NS3_ARGS} --timeDilation=${TIME_DILATION}"
+fi
+
+# ip netns keeps its handles under /run/netns, give it a private one
+if [[ -d /run/netns ]]; then
+    mount -t tmpfs tmpfs /run/netns
+else
+    mount -t tmpfs tmpfs /run
+    mkdir /run/netns
+fi
+
+pids=()
+cleanup() {
+    for pid in "${pids[@]}"; do
+        kill "${pid}" 2>/dev/null || true
+    done
+}
+trap cleanup EXIT
+
+echo "Create network..."
+ip link set lo up
+# name, mac address, ip address
+for ghost in "left 12:34:88:5D:61:BD 10.1.1.1" "right 5A:34:88:5D:61:BC 10.1.1.2" \
+             "server 5A:34:88:5D:61:BA 10.1.1.3"; do
+    read -r name mac addr <<< "${ghost}"
+    ip link add name "br-${name}" type bridge
+    ip tuntap add "tap-${name}" mode tap
+    ip link set "tap-${name}" promisc on master "br-${name}" up
+    ip link set "br-${name}" up
+
+    ip netns add "${name}"
+    ip link add "internal-${name}" type veth peer name eth0 netns "${name}"
+    ip link set "internal-${name}" master "br-${name}" up
+    ip -n "${name}" link set lo up
+    ip -n "${name}" link set eth0 address "${mac}" up
+    ip -n "${name}" addr add "${addr}/16" dev eth0
+done
+echo "Done."
+
+in_ns() {
+    local name=$1
+    shift
+    nsenter --net="/run/netns/${name}" "$@"
+}
+
+echo "### Setup complete. Starting simulation... ###"
+# Extra scenario arguments, e.g. NS3_ARGS="--numUes=200 --lowMemory=true --memoryReport=memory-report.csv"
+(cd "${NS3_DIR}" && exec ./ns3 run --no-build --cwd "${work}" \
+    "scratch/cttc-3gpp-channel-scratch ${NS3_ARGS}") > "${work}/ns3.log" 2>&1 &
+ns3_pid=$!
+pids+=("${ns3_pid}")
+echo "Starting server..."
+(cd "${REPO_DIR}/server" && exec nsenter --net=/run/netns/server "${work}/server") \
+    > "${work}/server.log" 2>&1 &
+pids+=("$!")
+
+# Ready once the server answers through the simulated network
+echo "Waiting for the server to be reachable from UE0..."
+ready=0
+for _ in $(seq 1 "$(awk -v k="${TIME_DILATION}" 'BEGIN { printf "%d", 200 * k }')"); do
+    if in_ns left curl -s -o /dev/null --max-time 0.2 10.1.1.3:8080; then
+        ready=1
+        break
+    fi
+    if ! kill -0 "${ns3_pid}" 2>/dev/null; then
+        echo "Simulation exited early, see ${work}/ns3.log" >&2
+        exit 1
+    fi
+    sleep 0.1
+done
+if [[ "${ready}" != 1 ]]; then
+    echo "Server not reachable from UE0, see ${work}/server.log and ${work}/ns3.log" >&2
+    exit 1
+fi
+awk -v s="${start}" -v e="$(date +%s.%N)" 'BEGIN { printf "Ready after %.2f s\n", e - s }'
+
+echo "Pinging server from UE0"
+in_ns left curl -X POST 10.1.1.3:8080 -d '{"activity":{"description":"get resource","time":"2021-12-24T12:42:31Z","device":"iphone","node":"healthy"}}' > "${work}/node1.log"
+in_ns left curl -X GET 10.1.1.3:8080 -d '{"id":0}' >> "${work}/node1.log"
+echo "Pinging server from UE1"
+in_ns right curl -X POST 10.1.1.3:8080 -d '{"activity":{"description":"get resource","time":"2021-12-24T12:43:31Z","device":"PC","node":"bad"}}' > "${work}/node2.log"
+in_ns left curl -X GET 10.1.1.3:8080 -d '{"id":1}' >> "${work}/node2.log"
+echo "Waiting for experiment to finish..."
+wait "${ns3_pid}"
+echo "Experiment completed."
+
+date=$(date +"%d%m%Y")
+n=1
+while [[ -d "${REPO_DIR}/results/${date}-${n}" ]] ; do
+    n=$(($n+1))
+done
+out="${REPO_DIR}/results/${date}-${n}"
+mkdir -p "${out}"
+mv "${work}"/*.log "${work}"/*.pcap "${out}"
+mv "${work}"/*-report.* "${out}" 2>/dev/null || true
+rm -rf "${work}"
+if [[ -x "${REPO_DIR}/tools/pcap-analyzer" ]]; then
+    echo "Analyzing captures..."
+    "${REPO_DIR}/tools/pcap-analyzer" --csv "${out}/analysis" "${out}"/*.pcap > "${out}/analysis.txt"
+fi
+echo "Results available at ${out}"
+echo "done."
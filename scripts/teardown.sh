@@ -1,19 +1,23 @@
 #!/bin/env bash
-# Down the bridges
-sudo ip link set br-left down
-sudo ip link set br-right down
+if [[ "${PLUMBING}" == netplumb ]]; then
+    sudo tools/netplumb teardown scenarios/plans/tap-csma-scenario.plan
+else
+    # Down the bridges
+    sudo ip link set br-left down
+    sudo ip link set br-right down
 
-# Remove the taps from the bridges
-sudo ip link set tap-left nomaster
-sudo ip link set tap-right nomaster
+    # Remove the taps from the bridges
+    sudo ip link set tap-left nomaster
+    sudo ip link set tap-right nomaster
 
-# Delete the bridges
-sudo ip link del br-left
-sudo ip link del br-right
+    # Delete the bridges
+    sudo ip link del br-left
+    sudo ip link del br-right
 
-# Delete the taps
-sudo ip link del tap-left
-sudo ip link del tap-right
+    # Delete the taps
+    sudo ip link del tap-left
+    sudo ip link del tap-right
+fi
 
 # Stop all running container
 docker compose -f scenarios/tap-csma-scenario.yaml down
@@ -0,0 +1,795 @@
+//
+// Applies and tears down the host plumbing of an emulation scenario.
+//
+// The start scripts build bridges, taps and veth pairs with dozens of
+// `sudo ip` calls, each one a fork plus its own netlink round trips.  netplumb
+// reads the same topology from a plan file and talks rtnetlink directly: taps
+// are created with the tun ioctls, and every other step of a phase goes to
+// the kernel as one batch of messages in a single sendmsg.  Veth peers are
+// created straight inside the container namespace, so there is no rename or
+// move step.  Both apply and teardown are idempotent: objects that already
+// exist (or are already gone) are not errors.
+//
+// Plan format, one statement per line, `#` starts a comment and ${VAR} is
+// replaced from the environment:
+//   sysctl  PATH VALUE                      (under /proc/sys, missing ones are skipped)
+//   bridge  NAME
+//   tap     NAME [master BRIDGE]            (persistent, promisc and up)
+//   veth    NAME [master BRIDGE] peer PEER netns NETNS [address MAC]
+//   addr    NETNS DEVICE ADDRESS/PREFIX
+//   route   NETNS DEVICE DESTINATION[/PREFIX]
+// NETNS is a pid (its /proc/PID/ns/net) or a name under /run/netns.
+//
+// Build:
+//   g++ -O2 -std=c++17 -o tools/netplumb tools/netplumb.cc
+//
+// Usage:
+//   netplumb apply|teardown PLAN
+//
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <linux/if_link.h>
+#include <linux/if_tun.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/veth.h>
+#include <net/if.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+struct Link
+{
+  std::string kind; // bridge, tap or veth
+  std::string name;
+  std::string master;
+  std::string peer;
+  std::string netns;
+  std::string address;
+};
+
+struct Address
+{
+  std::string netns;
+  std::string device;
+  in_addr addr;
+  uint8_t prefix;
+  bool route; // a device route instead of an interface address
+};
+
+struct Plan
+{
+  std::vector<std::pair<std::string, std::string>> sysctls;
+  std::vector<Link> links;
+  std::vector<Address> addresses;
+};
+
+std::string
+Expand (const std::string &line, bool strict)
+{
+  std::string out;
+  size_t pos = 0;
+  while (pos < line.size ())
+    {
+      size_t start = line.find ("${", pos);
+      if (start == std::string::npos)
+        {
+          out += line.substr (pos);
+          break;
+        }
+      size_t end = line.find ('}', start);
+      if (end == std::string::npos)
+        {
+          throw std::runtime_error ("unterminated ${ in: " + line);
+        }
+      out += line.substr (pos, start - pos);
+      std::string var = line.substr (start + 2, end - start - 2);
+      const char *value = std::getenv (var.c_str ());
+      if (value == nullptr && strict)
+        {
+          throw std::runtime_error ("variable " + var + " is not set");
+        }
+      // keep the word count intact when teardown leaves it unset
+      out += value ? value : "-";
+      pos = end + 1;
+    }
+  return out;
+}
+
+void
+ParsePrefix (const std::string &text, in_addr *addr, uint8_t *prefix)
+{
+  size_t slash = text.find ('/');
+  std::string host = text.substr (0, slash);
+  *prefix = slash == std::string::npos ? 32 : std::stoi (text.substr (slash + 1));
+  if (inet_pton (AF_INET, host.c_str (), addr) != 1 || *prefix > 32)
+    {
+      throw std::runtime_error ("bad IPv4 address: " + text);
+    }
+}
+
+// In teardown mode unset variables are allowed: only the host side link
+// names are needed to remove everything.
+Plan
+ReadPlan (const std::string &path, bool strict)
+{
+  std::ifstream in (path);
+  if (!in)
+    {
+      throw std::runtime_error ("cannot read plan " + path);
+    }
+  Plan plan;
+  std::string raw;
+  int lineNo = 0;
+  while (std::getline (in, raw))
+    {
+      ++lineNo;
+      std::string line = Expand (raw.substr (0, raw.find ('#')), strict);
+      std::istringstream words (line);
+      std::vector<std::string> w;
+      for (std::string word; words >> word;)
+        {
+          w.push_back (word);
+        }
+      if (w.empty ())
+        {
+          continue;
+        }
+      std::string where = path + ":" + std::to_string (lineNo) + ": ";
+      if (w[0] == "sysctl" && w.size () == 3)
+        {
+          plan.sysctls.emplace_back (w[1], w[2]);
+        }
+      else if ((w[0] == "bridge" || w[0] == "tap" || w[0] == "veth") && w.size () >= 2 &&
+               w.size () % 2 == 0)
+        {
+          Link link;
+          link.kind = w[0];
+          link.name = w[1];
+          for (size_t i = 2; i < w.size (); i += 2)
+            {
+              if (w[i] == "master")
+                {
+                  link.master = w[i + 1];
+                }
+              else if (w[i] == "peer")
+                {
+                  link.peer = w[i + 1];
+                }
+              else if (w[i] == "netns")
+                {
+                  link.netns = w[i + 1];
+                }
+              else if (w[i] == "address")
+                {
+                  link.address = w[i + 1];
+                }
+              else
+                {
+                  throw std::runtime_error (where + "unknown option " + w[i]);
+                }
+            }
+          if (link.kind == "veth" && (link.peer.empty () || (strict && link.netns.empty ())))
+            {
+              throw std::runtime_error (where + "veth needs peer and netns");
+            }
+          plan.links.push_back (link);
+        }
+      else if ((w[0] == "addr" || w[0] == "route") && w.size () == 4)
+        {
+          if (!strict)
+            {
+              continue;
+            }
+          Address address;
+          address.netns = w[1];
+          address.device = w[2];
+          address.route = w[0] == "route";
+          ParsePrefix (w[3], &address.addr, &address.prefix);
+          plan.addresses.push_back (address);
+        }
+      else
+        {
+          throw std::runtime_error (where + "cannot parse: " + raw);
+        }
+    }
+  return plan;
+}
+
+std::string
+NetnsPath (const std::string &netns)
+{
+  if (netns.find_first_not_of ("0123456789") == std::string::npos)
+    {
+      return "/proc/" + netns + "/ns/net";
+    }
+  return "/run/netns/" + netns;
+}
+
+int
+OpenNetns (const std::string &netns)
+{
+  int fd = open (NetnsPath (netns).c_str (), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    {
+      throw std::runtime_error ("cannot open network namespace " + netns + ": " +
+                                std::strerror (errno));
+    }
+  return fd;
+}
+
+// One rtnetlink request under construction
+class Message
+{
+public:
+  Message (uint16_t type, uint16_t flags) : m_buffer (NLMSG_HDRLEN)
+  {
+    Header ()->nlmsg_type = type;
+    Header ()->nlmsg_flags = NLM_F_REQUEST | NLM_F_ACK | flags;
+  }
+
+  template <typename T>
+  T *
+  Append (const T &payload)
+  {
+    size_t offset = m_buffer.size ();
+    m_buffer.resize (offset + NLMSG_ALIGN (sizeof (T)));
+    std::memcpy (m_buffer.data () + offset, &payload, sizeof (T));
+    return reinterpret_cast<T *> (m_buffer.data () + offset);
+  }
+
+  void
+  Attr (uint16_t type, const void *data, size_t len)
+  {
+    size_t offset = m_buffer.size ();
+    m_buffer.resize (offset + RTA_SPACE (len));
+    auto *rta = reinterpret_cast<rtattr *> (m_buffer.data () + offset);
+    rta->rta_type = type;
+    rta->rta_len = RTA_LENGTH (len);
+    std::memcpy (RTA_DATA (rta), data, len);
+  }
+
+  void
+  Attr (uint16_t type, const std::string &value)
+  {
+    Attr (type, value.c_str (), value.size () + 1);
+  }
+
+  void
+  Attr (uint16_t type, uint32_t value)
+  {
+    Attr (type, &value, sizeof (value));
+  }
+
+  size_t
+  BeginNest (uint16_t type)
+  {
+    size_t offset = m_buffer.size ();
+    Attr (type, nullptr, 0);
+    return offset;
+  }
+
+  void
+  EndNest (size_t offset)
+  {
+    reinterpret_cast<rtattr *> (m_buffer.data () + offset)->rta_len = m_buffer.size () - offset;
+  }
+
+  nlmsghdr *
+  Header ()
+  {
+    return reinterpret_cast<nlmsghdr *> (m_buffer.data ());
+  }
+
+  std::vector<char> &
+  Finish ()
+  {
+    Header ()->nlmsg_len = m_buffer.size ();
+    return m_buffer;
+  }
+
+private:
+  std::vector<char> m_buffer;
+};
+
+// An rtnetlink socket bound to one network namespace.  Requests are queued
+// and sent to the kernel together, which processes them in order and acks
+// each one.
+class Netlink
+{
+public:
+  explicit Netlink (int netnsFd = -1)
+  {
+    int self = -1;
+    if (netnsFd >= 0)
+      {
+        // the socket stays in the namespace it was created in
+        self = open ("/proc/self/ns/net", O_RDONLY | O_CLOEXEC);
+        if (self < 0)
+          {
+            throw std::runtime_error (std::string ("open own netns: ") + std::strerror (errno));
+          }
+        if (setns (netnsFd, CLONE_NEWNET) < 0)
+          {
+            int err = errno;
+            close (self);
+            throw std::runtime_error (std::string ("setns: ") + std::strerror (err));
+          }
+      }
+    m_fd = socket (AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    int err = errno;
+    if (self >= 0)
+      {
+        // carrying on in the target namespace would apply later steps there
+        int restored = setns (self, CLONE_NEWNET);
+        int restoreErr = errno;
+        close (self);
+        if (restored < 0)
+          {
+            if (m_fd >= 0)
+              {
+                close (m_fd);
+              }
+            throw std::runtime_error (std::string ("setns back to own netns: ") +
+                                      std::strerror (restoreErr));
+          }
+      }
+    if (m_fd < 0)
+      {
+        throw std::runtime_error (std::string ("netlink socket: ") + std::strerror (err));
+      }
+    int one = 1;
+    setsockopt (m_fd, SOL_NETLINK, NETLINK_CAP_ACK, &one, sizeof (one));
+    setsockopt (m_fd, SOL_NETLINK, NETLINK_EXT_ACK, &one, sizeof (one));
+  }
+
+  ~Netlink ()
+  {
+    close (m_fd);
+  }
+
+  Netlink (const Netlink &) = delete;
+  Netlink &operator= (const Netlink &) = delete;
+
+  // ignore lists the errno values that mean the work is already done
+  void
+  Queue (Message &message, const std::string &what, std::set<int> ignore = {})
+  {
+    message.Header ()->nlmsg_seq = ++m_seq;
+    std::vector<char> &bytes = message.Finish ();
+    m_batch.insert (m_batch.end (), bytes.begin (), bytes.end ());
+    m_pending[m_seq] = {what, ignore};
+  }
+
+  // Sends the queued requests in one message and collects the acks.
+  // Returns the number of failed requests.
+  int
+  Flush ()
+  {
+    if (m_pending.empty ())
+      {
+        return 0;
+      }
+    sockaddr_nl kernel = {};
+    kernel.nl_family = AF_NETLINK;
+    if (sendto (m_fd, m_batch.data (), m_batch.size (), 0, reinterpret_cast<sockaddr *> (&kernel),
+                sizeof (kernel)) < 0)
+      {
+        throw std::runtime_error (std::string ("netlink send: ") + std::strerror (errno));
+      }
+    m_batch.clear ();
+    ++m_roundTrips;
+    int failed = 0;
+    std::vector<char> buffer (1 << 16);
+    while (!m_pending.empty ())
+      {
+        ssize_t len = recv (m_fd, buffer.data (), buffer.size (), 0);
+        if (len < 0)
+          {
+            throw std::runtime_error (std::string ("netlink recv: ") + std::strerror (errno));
+          }
+        for (auto *h = reinterpret_cast<nlmsghdr *> (buffer.data ()); NLMSG_OK (h, len);
+             h = NLMSG_NEXT (h, len))
+          {
+            auto it = m_pending.find (h->nlmsg_seq);
+            if (h->nlmsg_type != NLMSG_ERROR || it == m_pending.end ())
+              {
+                continue;
+              }
+            int error = -static_cast<nlmsgerr *> (NLMSG_DATA (h))->error;
+            if (error != 0 && it->second.ignore.count (error) == 0)
+              {
+                std::cerr << it->second.what << ": " << std::strerror (error) << std::endl;
+                ++failed;
+              }
+            m_pending.erase (it);
+          }
+      }
+    return failed;
+  }
+
+  // Interface index of a device in this namespace, 0 if it does not exist
+  int
+  Index (const std::string &name)
+  {
+    Message message (RTM_GETLINK, 0);
+    message.Append (ifinfomsg{});
+    message.Attr (IFLA_IFNAME, name);
+    message.Header ()->nlmsg_flags &= ~NLM_F_ACK;
+    message.Header ()->nlmsg_seq = ++m_seq;
+    std::vector<char> &bytes = message.Finish ();
+    if (send (m_fd, bytes.data (), bytes.size (), 0) < 0)
+      {
+        throw std::runtime_error (std::string ("netlink send: ") + std::strerror (errno));
+      }
+    ++m_roundTrips;
+    std::vector<char> buffer (1 << 16);
+    for (;;)
+      {
+        ssize_t len = recv (m_fd, buffer.data (), buffer.size (), 0);
+        if (len < 0)
+          {
+            throw std::runtime_error (std::string ("netlink recv: ") + std::strerror (errno));
+          }
+        for (auto *h = reinterpret_cast<nlmsghdr *> (buffer.data ()); NLMSG_OK (h, len);
+             h = NLMSG_NEXT (h, len))
+          {
+            if (h->nlmsg_seq != m_seq)
+              {
+                continue;
+              }
+            if (h->nlmsg_type == RTM_NEWLINK)
+              {
+                return static_cast<ifinfomsg *> (NLMSG_DATA (h))->ifi_index;
+              }
+            if (h->nlmsg_type == NLMSG_ERROR)
+              {
+                return 0;
+              }
+          }
+      }
+  }
+
+  static int
+  RoundTrips ()
+  {
+    return m_roundTrips;
+  }
+
+private:
+  struct Pending
+  {
+    std::string what;
+    std::set<int> ignore;
+  };
+
+  int m_fd;
+  uint32_t m_seq = 0;
+  std::vector<char> m_batch;
+  std::map<uint32_t, Pending> m_pending;
+  static int m_roundTrips;
+};
+
+int Netlink::m_roundTrips = 0;
+
+void
+ParseMac (const std::string &text, uint8_t mac[6])
+{
+  unsigned b[6];
+  if (std::sscanf (text.c_str (), "%x:%x:%x:%x:%x:%x", &b[0], &b[1], &b[2], &b[3], &b[4],
+                   &b[5]) != 6)
+    {
+      throw std::runtime_error ("bad MAC address: " + text);
+    }
+  for (int i = 0; i < 6; ++i)
+    {
+      mac[i] = b[i];
+    }
+}
+
+// Same as `ip tuntap add NAME mode tap`, EBUSY means ns-3 holds it already
+int
+CreateTap (const std::string &name)
+{
+  int fd = open ("/dev/net/tun", O_RDWR | O_CLOEXEC);
+  if (fd < 0)
+    {
+      std::cerr << "open /dev/net/tun: " << std::strerror (errno) << std::endl;
+      return 1;
+    }
+  ifreq ifr = {};
+  ifr.ifr_flags = IFF_TAP | IFF_NO_PI;
+  std::strncpy (ifr.ifr_name, name.c_str (), IFNAMSIZ - 1);
+  int failed = 0;
+  if (ioctl (fd, TUNSETIFF, &ifr) < 0)
+    {
+      if (errno != EBUSY)
+        {
+          std::cerr << "tap " << name << ": " << std::strerror (errno) << std::endl;
+          failed = 1;
+        }
+    }
+  else if (ioctl (fd, TUNSETPERSIST, 1) < 0)
+    {
+      std::cerr << "tap " << name << " persist: " << std::strerror (errno) << std::endl;
+      failed = 1;
+    }
+  close (fd);
+  return failed;
+}
+
+// Sets flags, master and MAC of a device selected by name
+void
+QueueSetLink (Netlink &netlink, const std::string &name, unsigned flags, int master,
+              const std::string &address)
+{
+  Message message (RTM_NEWLINK, 0);
+  ifinfomsg info = {};
+  info.ifi_family = AF_UNSPEC;
+  info.ifi_flags = flags;
+  info.ifi_change = flags;
+  message.Append (info);
+  message.Attr (IFLA_IFNAME, name);
+  if (master > 0)
+    {
+      message.Attr (IFLA_MASTER, static_cast<uint32_t> (master));
+    }
+  if (!address.empty ())
+    {
+      uint8_t mac[6];
+      ParseMac (address, mac);
+      message.Attr (IFLA_ADDRESS, mac, sizeof (mac));
+    }
+  netlink.Queue (message, "configure " + name);
+}
+
+int
+Apply (const Plan &plan)
+{
+  using Clock = std::chrono::steady_clock;
+  auto start = Clock::now ();
+  int failed = 0;
+
+  for (const auto &[path, value] : plan.sysctls)
+    {
+      std::ofstream out ("/proc/sys/" + path);
+      out << value;
+    }
+
+  // taps and the links that live in this namespace
+  Netlink host;
+  std::map<std::string, int> netnsFds;
+  for (const Link &link : plan.links)
+    {
+      if (link.kind == "tap")
+        {
+          failed += CreateTap (link.name);
+          continue;
+        }
+      Message message (RTM_NEWLINK, NLM_F_CREATE | NLM_F_EXCL);
+      message.Append (ifinfomsg{});
+      message.Attr (IFLA_IFNAME, link.name);
+      size_t linkInfo = message.BeginNest (IFLA_LINKINFO);
+      message.Attr (IFLA_INFO_KIND, link.kind);
+      if (link.kind == "veth")
+        {
+          if (netnsFds.count (link.netns) == 0)
+            {
+              netnsFds[link.netns] = OpenNetns (link.netns);
+            }
+          size_t data = message.BeginNest (IFLA_INFO_DATA);
+          size_t peer = message.BeginNest (VETH_INFO_PEER);
+          message.Append (ifinfomsg{});
+          message.Attr (IFLA_IFNAME, link.peer);
+          message.Attr (IFLA_NET_NS_FD, static_cast<uint32_t> (netnsFds[link.netns]));
+          message.EndNest (peer);
+          message.EndNest (data);
+        }
+      message.EndNest (linkInfo);
+      host.Queue (message, "create " + link.kind + " " + link.name, {EEXIST});
+    }
+  failed += host.Flush ();
+  auto created = Clock::now ();
+
+  // enslave to the bridges and bring everything up
+  std::map<std::string, int> masters;
+  for (const Link &link : plan.links)
+    {
+      int master = 0;
+      if (!link.master.empty ())
+        {
+          if (masters.count (link.master) == 0)
+            {
+              masters[link.master] = if_nametoindex (link.master.c_str ());
+            }
+          master = masters[link.master];
+          if (master == 0)
+            {
+              std::cerr << link.name << ": no bridge " << link.master << std::endl;
+              ++failed;
+            }
+        }
+      unsigned flags = IFF_UP | (link.kind == "tap" ? IFF_PROMISC : 0);
+      QueueSetLink (host, link.name, flags, master, "");
+    }
+  failed += host.Flush ();
+  auto attached = Clock::now ();
+
+  // container side: one socket and one batch per namespace
+  std::map<std::string, std::vector<const Link *>> peers;
+  for (const Link &link : plan.links)
+    {
+      if (link.kind == "veth")
+        {
+          peers[link.netns].push_back (&link);
+        }
+    }
+  std::map<std::string, std::vector<const Address *>> addresses;
+  for (const Address &address : plan.addresses)
+    {
+      addresses[address.netns].push_back (&address);
+      if (netnsFds.count (address.netns) == 0)
+        {
+          netnsFds[address.netns] = OpenNetns (address.netns);
+        }
+    }
+  for (const auto &[netns, fd] : netnsFds)
+    {
+      Netlink inside (fd);
+      for (const Link *link : peers[netns])
+        {
+          QueueSetLink (inside, link->peer, IFF_UP, 0, link->address);
+        }
+      failed += inside.Flush ();
+      std::map<std::string, int> indexes;
+      for (const Address *address : addresses[netns])
+        {
+          if (indexes.count (address->device) == 0)
+            {
+              indexes[address->device] = inside.Index (address->device);
+            }
+          int index = indexes[address->device];
+          std::string what = (address->route ? "route " : "addr ") +
+                             std::string (inet_ntoa (address->addr)) + "/" +
+                             std::to_string (address->prefix) + " dev " + address->device +
+                             " in " + netns;
+          if (index == 0)
+            {
+              std::cerr << what << ": no such device" << std::endl;
+              ++failed;
+              continue;
+            }
+          if (address->route)
+            {
+              Message message (RTM_NEWROUTE, NLM_F_CREATE | NLM_F_EXCL);
+              rtmsg route = {};
+              route.rtm_family = AF_INET;
+              route.rtm_dst_len = address->prefix;
+              route.rtm_table = RT_TABLE_MAIN;
+              route.rtm_protocol = RTPROT_BOOT;
+              route.rtm_scope = RT_SCOPE_LINK;
+              route.rtm_type = RTN_UNICAST;
+              message.Append (route);
+              message.Attr (RTA_DST, &address->addr, sizeof (address->addr));
+              message.Attr (RTA_OIF, static_cast<uint32_t> (index));
+              inside.Queue (message, what, {EEXIST});
+            }
+          else
+            {
+              Message message (RTM_NEWADDR, NLM_F_CREATE | NLM_F_EXCL);
+              ifaddrmsg ifa = {};
+              ifa.ifa_family = AF_INET;
+              ifa.ifa_prefixlen = address->prefix;
+              ifa.ifa_scope = RT_SCOPE_UNIVERSE;
+              ifa.ifa_index = index;
+              message.Append (ifa);
+              message.Attr (IFA_LOCAL, &address->addr, sizeof (address->addr));
+              message.Attr (IFA_ADDRESS, &address->addr, sizeof (address->addr));
+              inside.Queue (message, what, {EEXIST});
+            }
+        }
+      failed += inside.Flush ();
+      close (fd);
+    }
+  auto done = Clock::now ();
+
+  auto ms = [] (Clock::time_point a, Clock::time_point b) {
+    return std::chrono::duration<double, std::milli> (b - a).count ();
+  };
+  std::fprintf (stderr,
+                "netplumb: applied %zu links and %zu addresses/routes in %.2f ms "
+                "(create %.2f, attach %.2f, namespaces %.2f; %d netlink round trips)\n",
+                plan.links.size (), plan.addresses.size (), ms (start, done),
+                ms (start, created), ms (created, attached), ms (attached, done),
+                Netlink::RoundTrips ());
+  return failed;
+}
+
+// Removing the host side of a veth pair removes its peer, and addresses and
+// routes go with their devices.
+int
+Teardown (const Plan &plan)
+{
+  auto start = std::chrono::steady_clock::now ();
+  Netlink host;
+  // enslaved devices first, then the bridges
+  for (int pass = 0; pass < 2; ++pass)
+    {
+      for (const Link &link : plan.links)
+        {
+          if ((link.kind == "bridge") != (pass == 1))
+            {
+              continue;
+            }
+          Message message (RTM_DELLINK, 0);
+          message.Append (ifinfomsg{});
+          message.Attr (IFLA_IFNAME, link.name);
+          host.Queue (message, "delete " + link.name, {ENODEV, ENOENT});
+        }
+    }
+  int failed = host.Flush ();
+  std::fprintf (stderr, "netplumb: removed %zu links in %.2f ms (%d netlink round trips)\n",
+                plan.links.size (),
+                std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now () -
+                                                           start)
+                    .count (),
+                Netlink::RoundTrips ());
+  return failed;
+}
+
+} // namespace
+
+int
+main (int argc, char *argv[])
+{
+  if (argc != 3 || (std::strcmp (argv[1], "apply") != 0 && std::strcmp (argv[1], "teardown") != 0))
+    {
+      std::cerr << "usage: " << argv[0] << " apply|teardown PLAN" << std::endl;
+      return 1;
+    }
+  bool apply = std::strcmp (argv[1], "apply") == 0;
+  try
+    {
+      Plan plan = ReadPlan (argv[2], apply);
+      int failed = apply ? Apply (plan) : Teardown (plan);
+      if (failed > 0)
+        {
+          std::cerr << "netplumb: " << failed << " step(s) failed" << std::endl;
+          return 1;
+        }
+    }
+  catch (const std::exception &e)
+    {
+      std::cerr << "netplumb: " << e.what () << std::endl;
+      return 1;
+    }
+  return 0;
+}
+/*
+ * ns3 network simulator code
+ * Copyright 2023 Carnegie Mellon University.
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * Released under a MIT (SEI)-style license, please see license.txt or contact permission@sei.cmu.edu for full terms.
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release and unlimited distribution.  Please see Copyright notice for non-US Government use and distribution.
+ * This Software includes and/or makes use of the following Third-Party Software subject to its own license:
+ * 1. ns-3 (https://www.nsnam.org/about/) Copyright 2011 nsnam.
+ * DM23-0109
+ */
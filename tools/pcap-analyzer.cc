@@ -0,0 +1,758 @@
+//
+// Offline analyzer for the pcaps produced by the emulation scenarios.
+//
+// Every CSMA device of a scenario writes its own capture (5gEmu-<node>-<dev>.pcap).
+// The analyzer memory-maps all of them, parses record ranges in parallel and
+// correlates the sightings of each IPv4 packet across capture points by its
+// flow (5-tuple) and IP identification.  The TTL tells the sightings apart:
+// the highest TTL is where the packet entered the simulated network and the
+// lowest one is the furthest hop it reached.  A packet that never reaches the
+// lowest TTL seen for its flow is counted as lost.  When several captures are
+// given, a flow that only ever shows up at a single TTL never reached another
+// capture point, so all of its packets are counted as lost.
+//
+// Build:
+//   g++ -O2 -std=c++17 -pthread -o tools/pcap-analyzer tools/pcap-analyzer.cc
+//
+// Usage:
+//   pcap-analyzer [--threads N] [--bin SECONDS] [--reuse-window SECONDS]
+//                 [--csv PREFIX] capture.pcap [capture.pcap ...]
+//
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+struct Options
+{
+  unsigned threads = 0;
+  double binSeconds = 0.1;
+  double reuseWindowSeconds = 2.0;
+  std::string csvPrefix;
+  std::vector<std::string> files;
+};
+
+// Memory mapping of a single capture file
+class MappedFile
+{
+public:
+  explicit MappedFile (const std::string &path) : m_path (path)
+  {
+    int fd = open (path.c_str (), O_RDONLY);
+    if (fd < 0)
+      {
+        return;
+      }
+    struct stat st;
+    if (fstat (fd, &st) == 0 && st.st_size > 0)
+      {
+        void *addr = mmap (nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED)
+          {
+            m_data = static_cast<const uint8_t *> (addr);
+            m_size = st.st_size;
+            madvise (addr, m_size, MADV_SEQUENTIAL);
+            madvise (addr, m_size, MADV_WILLNEED);
+          }
+      }
+    close (fd);
+  }
+
+  ~MappedFile ()
+  {
+    if (m_data)
+      {
+        munmap (const_cast<uint8_t *> (m_data), m_size);
+      }
+  }
+
+  MappedFile (const MappedFile &) = delete;
+  MappedFile &operator= (const MappedFile &) = delete;
+
+  const std::string m_path;
+  const uint8_t *m_data = nullptr;
+  size_t m_size = 0;
+};
+
+// Link types written by the ns-3 pcap helpers we care about
+enum LinkType : uint32_t
+{
+  LINK_ETHERNET = 1,
+  LINK_PPP = 9,
+  LINK_RAW = 101,
+  LINK_IPV4 = 228
+};
+
+struct PcapFormat
+{
+  bool valid = false;
+  bool swapped = false;
+  bool nanosecond = false;
+  uint32_t linkType = 0;
+};
+
+const size_t PCAP_GLOBAL_HEADER = 24;
+const size_t PCAP_RECORD_HEADER = 16;
+
+inline uint32_t
+Read32 (const uint8_t *p, bool swapped)
+{
+  uint32_t v;
+  std::memcpy (&v, p, sizeof (v));
+  return swapped ? __builtin_bswap32 (v) : v;
+}
+
+inline uint16_t
+ReadBe16 (const uint8_t *p)
+{
+  return static_cast<uint16_t> ((p[0] << 8) | p[1]);
+}
+
+inline uint32_t
+ReadBe32 (const uint8_t *p)
+{
+  return (uint32_t (p[0]) << 24) | (uint32_t (p[1]) << 16) | (uint32_t (p[2]) << 8) | p[3];
+}
+
+PcapFormat
+ParseGlobalHeader (const MappedFile &file)
+{
+  PcapFormat format;
+  if (file.m_size < PCAP_GLOBAL_HEADER)
+    {
+      return format;
+    }
+  uint32_t magic;
+  std::memcpy (&magic, file.m_data, sizeof (magic));
+  switch (magic)
+    {
+    case 0xa1b2c3d4:
+      break;
+    case 0xd4c3b2a1:
+      format.swapped = true;
+      break;
+    case 0xa1b23c4d:
+      format.nanosecond = true;
+      break;
+    case 0x4d3cb2a1:
+      format.swapped = true;
+      format.nanosecond = true;
+      break;
+    default:
+      return format;
+    }
+  format.linkType = Read32 (file.m_data + 20, format.swapped);
+  format.valid = true;
+  return format;
+}
+
+struct FlowKey
+{
+  uint32_t src = 0;
+  uint32_t dst = 0;
+  uint16_t srcPort = 0;
+  uint16_t dstPort = 0;
+  uint8_t protocol = 0;
+
+  bool
+  operator< (const FlowKey &o) const
+  {
+    return std::tie (src, dst, protocol, srcPort, dstPort) <
+           std::tie (o.src, o.dst, o.protocol, o.srcPort, o.dstPort);
+  }
+
+  bool
+  operator== (const FlowKey &o) const
+  {
+    return src == o.src && dst == o.dst && protocol == o.protocol && srcPort == o.srcPort &&
+           dstPort == o.dstPort;
+  }
+
+  uint64_t
+  Hash () const
+  {
+    uint64_t h = (uint64_t (src) << 32) ^ dst;
+    h ^= (uint64_t (srcPort) << 40) ^ (uint64_t (dstPort) << 24) ^ protocol;
+    h *= 0x9e3779b97f4a7c15ULL;
+    return h ^ (h >> 29);
+  }
+
+  std::string
+  ToString () const
+  {
+    char buf[96];
+    std::snprintf (buf, sizeof (buf), "%u.%u.%u.%u:%u -> %u.%u.%u.%u:%u/%u", src >> 24,
+                   (src >> 16) & 0xff, (src >> 8) & 0xff, src & 0xff, srcPort, dst >> 24,
+                   (dst >> 16) & 0xff, (dst >> 8) & 0xff, dst & 0xff, dstPort, protocol);
+    return buf;
+  }
+};
+
+// One observation of an IPv4 packet at one capture point
+struct Sighting
+{
+  FlowKey flow;
+  uint16_t ipId;
+  uint16_t fragOffset;
+  uint8_t ttl;
+  uint16_t ipLength;
+  int64_t timeNs;
+};
+
+// All sightings of one packet collapsed to where it entered and where it left
+struct PacketRecord
+{
+  FlowKey flow;
+  uint8_t maxTtl;
+  uint8_t minTtl;
+  uint16_t ipLength;
+  int64_t inNs;
+  int64_t outNs;
+};
+
+// A contiguous range of records inside one mapped file
+struct Chunk
+{
+  const MappedFile *file;
+  PcapFormat format;
+  size_t begin;
+  size_t end;
+};
+
+bool
+ParseIpv4 (const uint8_t *ip, size_t len, int64_t timeNs, Sighting &s)
+{
+  if (len < 20 || (ip[0] >> 4) != 4)
+    {
+      return false;
+    }
+  size_t ihl = (ip[0] & 0x0f) * 4;
+  if (ihl < 20 || len < ihl)
+    {
+      return false;
+    }
+  s.ipLength = ReadBe16 (ip + 2);
+  s.ipId = ReadBe16 (ip + 4);
+  s.fragOffset = ReadBe16 (ip + 6) & 0x1fff;
+  s.ttl = ip[8];
+  s.flow.protocol = ip[9];
+  s.flow.src = ReadBe32 (ip + 12);
+  s.flow.dst = ReadBe32 (ip + 16);
+  s.flow.srcPort = 0;
+  s.flow.dstPort = 0;
+  s.timeNs = timeNs;
+  // Only the first fragment carries the transport header; later fragments are
+  // accounted to the port-less flow of the same hosts
+  bool hasPorts = s.flow.protocol == 6 || s.flow.protocol == 17 || s.flow.protocol == 132;
+  if (hasPorts && s.fragOffset == 0 && len >= ihl + 4)
+    {
+      s.flow.srcPort = ReadBe16 (ip + ihl);
+      s.flow.dstPort = ReadBe16 (ip + ihl + 2);
+    }
+  return true;
+}
+
+bool
+ParseFrame (uint32_t linkType, const uint8_t *frame, size_t len, int64_t timeNs, Sighting &s)
+{
+  switch (linkType)
+    {
+      case LINK_ETHERNET: {
+        size_t offset = 12;
+        if (len < offset + 2)
+          {
+            return false;
+          }
+        uint16_t etherType = ReadBe16 (frame + offset);
+        // skip 802.1Q/802.1ad tags
+        while ((etherType == 0x8100 || etherType == 0x88a8) && len >= offset + 6)
+          {
+            offset += 4;
+            etherType = ReadBe16 (frame + offset);
+          }
+        if (etherType != 0x0800)
+          {
+            return false;
+          }
+        offset += 2;
+        return ParseIpv4 (frame + offset, len - offset, timeNs, s);
+      }
+      case LINK_PPP: {
+        if (len < 2 || ReadBe16 (frame) != 0x0021)
+          {
+            return false;
+          }
+        return ParseIpv4 (frame + 2, len - 2, timeNs, s);
+      }
+    case LINK_RAW:
+    case LINK_IPV4:
+      return ParseIpv4 (frame, len, timeNs, s);
+    default:
+      return false;
+    }
+}
+
+// Walks the record headers only and cuts the file into roughly equal ranges
+void
+SplitFile (const MappedFile &file, const PcapFormat &format, size_t targetChunks,
+           std::vector<Chunk> &chunks)
+{
+  size_t chunkBytes = std::max<size_t> (file.m_size / std::max<size_t> (targetChunks, 1), 1);
+  size_t offset = PCAP_GLOBAL_HEADER;
+  size_t begin = offset;
+  while (offset + PCAP_RECORD_HEADER <= file.m_size)
+    {
+      uint32_t capLen = Read32 (file.m_data + offset + 8, format.swapped);
+      size_t next = offset + PCAP_RECORD_HEADER + capLen;
+      if (next > file.m_size)
+        {
+          break;
+        }
+      offset = next;
+      if (offset - begin >= chunkBytes)
+        {
+          chunks.push_back ({&file, format, begin, offset});
+          begin = offset;
+        }
+    }
+  if (offset > begin)
+    {
+      chunks.push_back ({&file, format, begin, offset});
+    }
+}
+
+void
+ParseChunk (const Chunk &chunk, size_t shards, std::vector<std::vector<Sighting>> &out)
+{
+  const uint8_t *data = chunk.file->m_data;
+  const bool swapped = chunk.format.swapped;
+  const int64_t fraction = chunk.format.nanosecond ? 1 : 1000;
+  size_t offset = chunk.begin;
+  Sighting s;
+  while (offset + PCAP_RECORD_HEADER <= chunk.end)
+    {
+      const uint8_t *hdr = data + offset;
+      int64_t sec = Read32 (hdr, swapped);
+      int64_t sub = Read32 (hdr + 4, swapped);
+      uint32_t capLen = Read32 (hdr + 8, swapped);
+      offset += PCAP_RECORD_HEADER;
+      if (ParseFrame (chunk.format.linkType, data + offset, capLen,
+                      sec * 1000000000LL + sub * fraction, s))
+        {
+          uint64_t h = s.flow.Hash () ^ (uint64_t (s.ipId) * 0xff51afd7ed558ccdULL);
+          out[(h >> 32) % shards].push_back (s);
+        }
+      offset += capLen;
+    }
+}
+
+// Groups the sightings of one shard into packets.  Sightings of the same
+// (flow, ip id, fragment) further apart than the reuse window belong to
+// different packets, which copes with the 16-bit IP ID wrapping on long runs.
+void
+CorrelateShard (std::vector<Sighting> &sightings, int64_t reuseWindowNs,
+                std::vector<PacketRecord> &packets)
+{
+  std::sort (sightings.begin (), sightings.end (), [] (const Sighting &a, const Sighting &b) {
+    return std::tie (a.flow, a.ipId, a.fragOffset, a.timeNs) <
+           std::tie (b.flow, b.ipId, b.fragOffset, b.timeNs);
+  });
+
+  size_t i = 0;
+  while (i < sightings.size ())
+    {
+      const Sighting &first = sightings[i];
+      PacketRecord record{first.flow, first.ttl, first.ttl, first.ipLength, first.timeNs,
+                          first.timeNs};
+      size_t j = i + 1;
+      while (j < sightings.size () && sightings[j].flow == first.flow &&
+             sightings[j].ipId == first.ipId && sightings[j].fragOffset == first.fragOffset &&
+             sightings[j].timeNs - first.timeNs <= reuseWindowNs)
+        {
+          const Sighting &s = sightings[j];
+          // sightings are time ordered, so the first one at a given TTL is kept
+          if (s.ttl > record.maxTtl)
+            {
+              record.maxTtl = s.ttl;
+              record.inNs = s.timeNs;
+            }
+          if (s.ttl < record.minTtl)
+            {
+              record.minTtl = s.ttl;
+              record.outNs = s.timeNs;
+            }
+          ++j;
+        }
+      packets.push_back (record);
+      i = j;
+    }
+}
+
+struct FlowStats
+{
+  FlowKey flow;
+  uint64_t packets = 0;
+  uint64_t delivered = 0;
+  uint64_t bytesIn = 0;
+  uint64_t bytesOut = 0;
+  int64_t firstNs = 0;
+  int64_t lastNs = 0;
+  std::vector<int64_t> latencyNs;
+  std::map<int64_t, uint64_t> bytesPerBin;
+};
+
+void
+SummarizeFlow (std::vector<PacketRecord>::iterator begin, std::vector<PacketRecord>::iterator end,
+               int64_t binNs, bool multiCapture, FlowStats &stats)
+{
+  stats.flow = begin->flow;
+  uint8_t flowMinTtl = begin->minTtl;
+  uint8_t flowMaxTtl = begin->maxTtl;
+  for (auto it = begin; it != end; ++it)
+    {
+      flowMinTtl = std::min (flowMinTtl, it->minTtl);
+      flowMaxTtl = std::max (flowMaxTtl, it->maxTtl);
+    }
+  // With a single capture there is no egress point to compare against; with
+  // several, a flow seen at one TTL only never left the ingress point
+  const bool egressSeen = flowMinTtl != flowMaxTtl || !multiCapture;
+  stats.firstNs = begin->inNs;
+  stats.lastNs = begin->outNs;
+  for (auto it = begin; it != end; ++it)
+    {
+      // Packets that only show up mid-path (e.g. traffic originated inside the
+      // simulation) are not counted against the ingress point
+      if (it->maxTtl != flowMaxTtl)
+        {
+          continue;
+        }
+      ++stats.packets;
+      stats.bytesIn += it->ipLength;
+      stats.firstNs = std::min (stats.firstNs, it->inNs);
+      if (!egressSeen || it->minTtl != flowMinTtl)
+        {
+          continue;
+        }
+      ++stats.delivered;
+      stats.bytesOut += it->ipLength;
+      stats.lastNs = std::max (stats.lastNs, it->outNs);
+      if (flowMinTtl != flowMaxTtl)
+        {
+          stats.latencyNs.push_back (it->outNs - it->inNs);
+        }
+      stats.bytesPerBin[it->outNs / binNs] += it->ipLength;
+    }
+  std::sort (stats.latencyNs.begin (), stats.latencyNs.end ());
+}
+
+double
+PercentileMs (const std::vector<int64_t> &sorted, double q)
+{
+  if (sorted.empty ())
+    {
+      return NAN;
+    }
+  size_t index = static_cast<size_t> (std::ceil (q * sorted.size ()));
+  index = std::min (std::max<size_t> (index, 1), sorted.size ()) - 1;
+  return sorted[index] / 1e6;
+}
+
+template <typename F>
+void
+ParallelFor (size_t count, unsigned threads, F &&body)
+{
+  std::atomic<size_t> next{0};
+  std::vector<std::thread> pool;
+  for (unsigned t = 0; t < threads; ++t)
+    {
+      pool.emplace_back ([&, t] () {
+        for (size_t i = next++; i < count; i = next++)
+          {
+            body (i, t);
+          }
+      });
+    }
+  for (auto &th : pool)
+    {
+      th.join ();
+    }
+}
+
+void
+Usage (const char *argv0)
+{
+  std::cerr << "usage: " << argv0
+            << " [--threads N] [--bin SECONDS] [--reuse-window SECONDS] [--csv PREFIX]"
+               " capture.pcap [capture.pcap ...]"
+            << std::endl;
+}
+
+// Accepts the whole string as a number and nothing else
+bool
+ParseNumber (const char *text, unsigned &value)
+{
+  char *end = nullptr;
+  errno = 0;
+  unsigned long parsed = std::strtoul (text, &end, 10);
+  if (end == text || *end != '\0' || errno != 0 || text[0] == '-' || parsed > UINT_MAX)
+    {
+      std::cerr << "invalid number: " << text << std::endl;
+      return false;
+    }
+  value = static_cast<unsigned> (parsed);
+  return true;
+}
+
+bool
+ParseNumber (const char *text, double &value)
+{
+  char *end = nullptr;
+  errno = 0;
+  double parsed = std::strtod (text, &end);
+  if (end == text || *end != '\0' || errno != 0 || !std::isfinite (parsed))
+    {
+      std::cerr << "invalid number: " << text << std::endl;
+      return false;
+    }
+  value = parsed;
+  return true;
+}
+
+bool
+ParseOptions (int argc, char *argv[], Options &options)
+{
+  for (int i = 1; i < argc; ++i)
+    {
+      std::string arg = argv[i];
+      bool hasValue = i + 1 < argc;
+      if (arg == "--threads" && hasValue)
+        {
+          if (!ParseNumber (argv[++i], options.threads))
+            {
+              return false;
+            }
+        }
+      else if (arg == "--bin" && hasValue)
+        {
+          if (!ParseNumber (argv[++i], options.binSeconds))
+            {
+              return false;
+            }
+        }
+      else if (arg == "--reuse-window" && hasValue)
+        {
+          if (!ParseNumber (argv[++i], options.reuseWindowSeconds))
+            {
+              return false;
+            }
+        }
+      else if (arg == "--csv" && hasValue)
+        {
+          options.csvPrefix = argv[++i];
+        }
+      else if (!arg.empty () && arg[0] == '-')
+        {
+          return false;
+        }
+      else
+        {
+          options.files.push_back (arg);
+        }
+    }
+  return !options.files.empty () && options.binSeconds > 0 && options.reuseWindowSeconds >= 0;
+}
+
+void
+WriteCsv (const std::string &prefix, const std::vector<FlowStats> &flows, int64_t binNs)
+{
+  std::ofstream summary (prefix + "-flows.csv");
+  summary << "flow,packets,delivered,loss,bytes_in,bytes_out,latency_min_ms,latency_p50_ms,"
+             "latency_p90_ms,latency_p99_ms,latency_max_ms,latency_mean_ms\n";
+  std::ofstream latency (prefix + "-latency.csv");
+  latency << "flow,latency_ms\n";
+  std::ofstream throughput (prefix + "-throughput.csv");
+  throughput << "flow,time_s,bytes,mbps\n";
+  for (const auto &f : flows)
+    {
+      std::string name = f.flow.ToString ();
+      double mean = 0;
+      for (int64_t l : f.latencyNs)
+        {
+          mean += l;
+          latency << name << ',' << l / 1e6 << '\n';
+        }
+      mean = f.latencyNs.empty () ? NAN : mean / f.latencyNs.size () / 1e6;
+      summary << name << ',' << f.packets << ',' << f.delivered << ','
+              << (f.packets ? double (f.packets - f.delivered) / f.packets : 0) << ','
+              << f.bytesIn << ',' << f.bytesOut << ',' << PercentileMs (f.latencyNs, 0) << ','
+              << PercentileMs (f.latencyNs, 0.5) << ',' << PercentileMs (f.latencyNs, 0.9) << ','
+              << PercentileMs (f.latencyNs, 0.99) << ',' << PercentileMs (f.latencyNs, 1) << ','
+              << mean << '\n';
+      for (const auto &bin : f.bytesPerBin)
+        {
+          throughput << name << ',' << bin.first * binNs / 1e9 << ',' << bin.second << ','
+                     << bin.second * 8 / (binNs / 1e9) / 1e6 << '\n';
+        }
+    }
+}
+
+} // namespace
+
+int
+main (int argc, char *argv[])
+{
+  Options options;
+  if (!ParseOptions (argc, argv, options))
+    {
+      Usage (argv[0]);
+      return 1;
+    }
+  unsigned threads = options.threads ? options.threads : std::thread::hardware_concurrency ();
+  threads = std::max (threads, 1u);
+  const int64_t binNs = static_cast<int64_t> (options.binSeconds * 1e9);
+  const int64_t reuseWindowNs = static_cast<int64_t> (options.reuseWindowSeconds * 1e9);
+
+  auto start = std::chrono::steady_clock::now ();
+
+  std::vector<std::unique_ptr<MappedFile>> files;
+  std::vector<Chunk> chunks;
+  uint64_t totalBytes = 0;
+  size_t unreadable = 0;
+  for (const auto &path : options.files)
+    {
+      files.emplace_back (new MappedFile (path));
+      const MappedFile &file = *files.back ();
+      PcapFormat format = ParseGlobalHeader (file);
+      if (!format.valid)
+        {
+          std::cerr << "skipping " << path << ": not a readable pcap file" << std::endl;
+          ++unreadable;
+          continue;
+        }
+      totalBytes += file.m_size;
+      SplitFile (file, format, threads, chunks);
+    }
+
+  // Parse: every chunk lands in per-thread, per-shard buckets so no locking is needed
+  const size_t shards = threads * 4;
+  std::vector<std::vector<std::vector<Sighting>>> parsed (
+      threads, std::vector<std::vector<Sighting>> (shards));
+  ParallelFor (chunks.size (), threads,
+               [&] (size_t i, unsigned t) { ParseChunk (chunks[i], shards, parsed[t]); });
+
+  // Correlate each shard into packets
+  std::vector<std::vector<PacketRecord>> packets (shards);
+  ParallelFor (shards, threads, [&] (size_t shard, unsigned) {
+    std::vector<Sighting> merged;
+    size_t total = 0;
+    for (unsigned t = 0; t < threads; ++t)
+      {
+        total += parsed[t][shard].size ();
+      }
+    merged.reserve (total);
+    for (unsigned t = 0; t < threads; ++t)
+      {
+        auto &part = parsed[t][shard];
+        merged.insert (merged.end (), part.begin (), part.end ());
+        std::vector<Sighting> ().swap (part);
+      }
+    CorrelateShard (merged, reuseWindowNs, packets[shard]);
+  });
+
+  // Regroup packets by flow and summarize each flow
+  const bool multiCapture = options.files.size () - unreadable > 1;
+  std::vector<std::vector<PacketRecord>> byFlow (shards);
+  for (auto &shard : packets)
+    {
+      for (const auto &p : shard)
+        {
+          byFlow[p.flow.Hash () % shards].push_back (p);
+        }
+      std::vector<PacketRecord> ().swap (shard);
+    }
+  std::vector<std::vector<FlowStats>> flowShards (shards);
+  ParallelFor (shards, threads, [&] (size_t shard, unsigned) {
+    auto &records = byFlow[shard];
+    std::sort (records.begin (), records.end (),
+               [] (const PacketRecord &a, const PacketRecord &b) { return a.flow < b.flow; });
+    auto it = records.begin ();
+    while (it != records.end ())
+      {
+        auto end = std::find_if (it, records.end (),
+                                 [&] (const PacketRecord &p) { return !(p.flow == it->flow); });
+        flowShards[shard].emplace_back ();
+        SummarizeFlow (it, end, binNs, multiCapture, flowShards[shard].back ());
+        it = end;
+      }
+  });
+
+  std::vector<FlowStats> flows;
+  for (auto &shard : flowShards)
+    {
+      for (auto &f : shard)
+        {
+          flows.push_back (std::move (f));
+        }
+    }
+  std::sort (flows.begin (), flows.end (),
+             [] (const FlowStats &a, const FlowStats &b) { return a.flow < b.flow; });
+
+  auto elapsed =
+      std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+
+  std::printf ("%-44s %9s %9s %7s %9s %9s %9s %9s %10s\n", "flow", "packets", "lost", "loss%",
+               "p50(ms)", "p90(ms)", "p99(ms)", "max(ms)", "Mbps");
+  for (const auto &f : flows)
+    {
+      double duration = (f.lastNs - f.firstNs) / 1e9;
+      double mbps = duration > 0 ? f.bytesOut * 8 / duration / 1e6 : 0;
+      uint64_t lost = f.packets - f.delivered;
+      std::printf ("%-44s %9" PRIu64 " %9" PRIu64 " %7.2f %9.3f %9.3f %9.3f %9.3f %10.3f\n",
+                   f.flow.ToString ().c_str (), f.packets, lost,
+                   f.packets ? 100.0 * lost / f.packets : 0.0, PercentileMs (f.latencyNs, 0.5),
+                   PercentileMs (f.latencyNs, 0.9), PercentileMs (f.latencyNs, 0.99),
+                   PercentileMs (f.latencyNs, 1), mbps);
+    }
+  std::fprintf (stderr, "analyzed %zu files (%.1f MB) in %.3f s using %u threads\n",
+                options.files.size (), totalBytes / 1e6, elapsed, threads);
+
+  if (!options.csvPrefix.empty ())
+    {
+      WriteCsv (options.csvPrefix, flows, binNs);
+    }
+  // The report above still covers the readable captures, but a missing input
+  // must not look like a clean run to scripts
+  return unreadable ? 2 : 0;
+}
+/*
+ * ns3 network simulator code
+ * Copyright 2023 Carnegie Mellon University.
+ * NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT, TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * Released under a MIT (SEI)-style license, please see license.txt or contact permission@sei.cmu.edu for full terms.
+ * [DISTRIBUTION STATEMENT A] This material has been approved for public release and unlimited distribution.  Please see Copyright notice for non-US Government use and distribution.
+ * This Software includes and/or makes use of the following Third-Party Software subject to its own license:
+ * 1. ns-3 (https://www.nsnam.org/about/) Copyright 2011 nsnam.
+ * DM23-0109
+ */